@@ -1,7 +1,14 @@
 #include "Algorithms.hpp"
-#include <climits>
+#include "ThreadPool.hpp"
 #include <queue>
 #include <algorithm>
+#include <functional>
+#include <utility>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <limits>
+#include <type_traits>
 //orel55551234@gmail.com
 //orel nissan
 //322861527
@@ -9,218 +16,1322 @@ using namespace std;
 using namespace ariel;
 
 namespace {
-    const int INFINITY_INT = INT_MAX;
     const size_t UNDEFINED_SIZE_T = static_cast<size_t>(-1);
 
+    // Distance of unreachable vertices
+    template <typename Weight>
+    Weight infinity() {
+        return BasicGraph<Weight>::INFINITE_DISTANCE;
+    }
+
+    template <typename Number>
+    Number saturatingAdd(Number a, Number b, false_type /*integral*/) {
+        return a + b; // IEEE sums already saturate to infinity
+    }
+
+    template <typename Number>
+    Number saturatingAdd(Number a, Number b, true_type /*integral*/) {
+        Number sum;
+        if (__builtin_add_overflow(a, b, &sum)) {
+            return b < 0 ? numeric_limits<Number>::lowest() : numeric_limits<Number>::max();
+        }
+        return sum;
+    }
+
+    // Relaxation arithmetic, fixed at compile time per weight type so the hot loops carry no
+    // overflow checks of their own. Distance is the type path lengths accumulate in: long long
+    // for integer weights of up to 32 bits, where no path or negative-cycle walk the algorithms
+    // take can wrap and add() is a plain addition; the weight type itself otherwise, with 64-bit
+    // integer sums saturating at the ends of the range.
+    //
+    // A distance at the saturated floor (saturated()) can no longer drop, so the negative-cycle
+    // searches let a relaxation that lands on the floor through a longer path win the tie; only a
+    // negative cycle keeps those paths growing until they close a loop.
+    template <typename Weight, bool Widen = is_integral<Weight>::value && sizeof(Weight) <= sizeof(int32_t)>
+    struct Relaxation {
+        typedef long long Distance;
+        static Distance unreachable() { return numeric_limits<Distance>::max(); }
+        static Distance add(Distance a, Distance b) { return a + b; }
+        static bool saturated(Distance /*distance*/) { return false; }
+    };
+
+    template <typename Weight>
+    struct Relaxation<Weight, false> {
+        typedef Weight Distance;
+        static Distance unreachable() { return infinity<Weight>(); }
+        static Distance add(Distance a, Distance b) { return saturatingAdd(a, b, is_integral<Weight>()); }
+        static bool saturated(Distance distance) { return distance <= numeric_limits<Weight>::lowest(); }
+    };
+
+    template <typename Weight>
+    size_t vertexCount(const BasicGraph<Weight>& graph) {
+        return static_cast<size_t>(graph.getRows());
+    }
+
+    // Call visit(neighbor, weight) for every edge leaving vertex: sparse graphs walk their CSR
+    // index, dense graphs scan the matrix row. Returns false as soon as visit returns false.
+    template <typename Weight, typename Visitor>
+    bool forEachNeighbor(const BasicGraph<Weight>& graph, size_t vertex, Visitor visit) {
+        if (graph.isSparse()) {
+            const BasicSparseAdjacency<Weight>& adjacency = graph.getSparseAdjacency();
+            for (size_t edge = adjacency.offsets[vertex]; edge < adjacency.offsets[vertex + 1]; ++edge) {
+                if (!visit(adjacency.neighbors[edge], adjacency.weights[edge])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        const BasicRowView<Weight> row = graph.getAdjacencyMatrix()[vertex];
+        for (size_t j = 0; j < row.size(); ++j) {
+            if (row[j] != 0 && !visit(j, row[j])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Call visit(predecessor, weight) for every edge entering vertex: sparse graphs walk their
+    // reverse CSR index, dense graphs scan the matrix column. Returns false as soon as visit does.
+    template <typename Weight, typename Visitor>
+    bool forEachPredecessor(const BasicGraph<Weight>& graph, size_t vertex, Visitor visit) {
+        if (graph.isSparse()) {
+            const BasicSparseAdjacency<Weight>& adjacency = graph.getReverseSparseAdjacency();
+            for (size_t edge = adjacency.offsets[vertex]; edge < adjacency.offsets[vertex + 1]; ++edge) {
+                if (!visit(adjacency.neighbors[edge], adjacency.weights[edge])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        const BasicMatrixView<Weight> matrix = graph.getAdjacencyMatrix();
+        for (size_t i = 0; i < matrix.size(); ++i) {
+            Weight weight = matrix[i][vertex];
+            if (weight != 0 && !visit(i, weight)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Resumable edge enumeration for the iterative DFS: finds the first edge leaving vertex at or
+    // after position cursor, stores its endpoint in neighbor and moves cursor past it.
+    // Returns false once the edges of vertex are exhausted.
+    template <typename Weight>
+    bool nextNeighbor(const BasicGraph<Weight>& graph, size_t vertex, size_t& cursor, size_t& neighbor) {
+        if (graph.isSparse()) {
+            const BasicSparseAdjacency<Weight>& adjacency = graph.getSparseAdjacency();
+            size_t edge = adjacency.offsets[vertex] + cursor;
+            if (edge >= adjacency.offsets[vertex + 1]) {
+                return false;
+            }
+            neighbor = adjacency.neighbors[edge];
+            ++cursor;
+            return true;
+        }
+
+        const BasicRowView<Weight> row = graph.getAdjacencyMatrix()[vertex];
+        while (cursor < row.size()) {
+            size_t col = cursor++;
+            if (row[col] != 0) {
+                neighbor = col;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t lowestSetBit(uint64_t word) {
+#if defined(__GNUC__)
+        return static_cast<size_t>(__builtin_ctzll(word));
+#else
+        size_t bit = 0;
+        while ((word & 1U) == 0) {
+            word >>= 1U;
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    // Append the vertex of every set bit in word number wordIndex to out
+    void appendSetBits(uint64_t word, size_t wordIndex, vector<size_t>& out) {
+        while (word != 0) {
+            out.push_back(wordIndex * BitMatrix::WORD_BITS + lowestSetBit(word));
+            word &= word - 1; // Clear the lowest set bit
+        }
+    }
+
+    // Word-parallel BFS from vertex 0: each frontier vertex claims all of its unvisited
+    // neighbors at once with row & ~visited, 64 vertices per word.
+    bool isConnectedBitParallel(const BitMatrix& bits) {
+        size_t words = bits.getWordsPerRow();
+        vector<uint64_t> visited(words, 0);
+        vector<size_t> frontier(1, 0);
+        vector<size_t> nextFrontier;
+        visited[0] = 1U;
+        size_t reached = 1;
+
+        while (!frontier.empty()) {
+            nextFrontier.clear();
+            for (size_t vertex : frontier) {
+                const uint64_t* row = bits.row(vertex);
+                for (size_t w = 0; w < words; ++w) {
+                    uint64_t fresh = row[w] & ~visited[w];
+                    visited[w] |= fresh;
+                    appendSetBits(fresh, w, nextFrontier);
+                }
+            }
+            reached += nextFrontier.size();
+            frontier.swap(nextFrontier);
+        }
+        return reached == bits.size();
+    }
+
+    // Smallest sparse graph whose connectivity check runs the parallel BFS instead of a DFS
+    const size_t PARALLEL_BFS_MIN_VERTICES = 1024;
+
+    // Direction switching thresholds (Beamer et al.): go bottom-up once the frontier's edges exceed
+    // 1/BFS_ALPHA of the unexplored edges, back top-down once fewer than 1/BFS_BETA of the vertices
+    // are in the frontier
+    const size_t BFS_ALPHA = 14;
+    const size_t BFS_BETA = 24;
+
+    // Level-synchronous, direction-optimizing BFS from vertex 0 of a sparse graph on the shared pool.
+    // Top-down levels expand the frontier's outgoing CSR rows; bottom-up levels let every unvisited
+    // vertex scan its incoming edges for a frontier parent, which is cheaper once the frontier is
+    // large. Vertices are claimed in an atomic visited bitmap and each chunk collects the next
+    // frontier in its own buffer. Returns true if every vertex was reached.
+    template <typename Weight>
+    bool isConnectedParallelBfs(const BasicGraph<Weight>& graph) {
+        const BasicSparseAdjacency<Weight>& outgoing = graph.getSparseAdjacency();
+        const BasicSparseAdjacency<Weight>& incoming = graph.getReverseSparseAdjacency();
+        const size_t wordBits = BitMatrix::WORD_BITS;
+        size_t adjSize = vertexCount(graph);
+        size_t words = (adjSize + wordBits - 1) / wordBits;
+
+        vector<atomic<uint64_t>> visited(words);
+        for (atomic<uint64_t>& word : visited) {
+            word.store(0, memory_order_relaxed);
+        }
+        // True for the one thread that flips the bit of vertex from 0 to 1
+        auto claim = [&](size_t vertex) {
+            uint64_t bit = uint64_t(1) << (vertex % wordBits);
+            atomic<uint64_t>& word = visited[vertex / wordBits];
+            // Most candidates are already visited; a plain load keeps their cache line shared
+            if ((word.load(memory_order_relaxed) & bit) != 0) {
+                return false;
+            }
+            return (word.fetch_or(bit, memory_order_relaxed) & bit) == 0;
+        };
+        auto outDegree = [&](size_t vertex) { return outgoing.offsets[vertex + 1] - outgoing.offsets[vertex]; };
+
+        ThreadPool& pool = ThreadPool::shared();
+        mutex mergeMutex;
+        vector<size_t> frontier(1, 0);
+        vector<size_t> nextFrontier;
+        vector<uint64_t> frontierBits(words, 0);
+        claim(0);
+        size_t reached = 1;
+        size_t unexploredEdges = outgoing.neighbors.size() - outDegree(0);
+        bool bottomUp = false;
+
+        while (!frontier.empty()) {
+            size_t frontierEdges = 0;
+            for (size_t vertex : frontier) {
+                frontierEdges += outDegree(vertex);
+            }
+            if (!bottomUp) {
+                bottomUp = frontierEdges * BFS_ALPHA > unexploredEdges;
+            } else {
+                bottomUp = frontier.size() * BFS_BETA >= adjSize;
+            }
+
+            nextFrontier.clear();
+            // Each chunk fills a private buffer and appends it once, so the lock is taken once per chunk
+            auto mergeLocal = [&](const vector<size_t>& local) {
+                lock_guard<mutex> lock(mergeMutex);
+                nextFrontier.insert(nextFrontier.end(), local.begin(), local.end());
+            };
+
+            if (bottomUp) {
+                fill(frontierBits.begin(), frontierBits.end(), 0);
+                for (size_t vertex : frontier) {
+                    frontierBits[vertex / wordBits] |= uint64_t(1) << (vertex % wordBits);
+                }
+                pool.parallelFor(0, adjSize, [&](size_t first, size_t last) {
+                    vector<size_t> local;
+                    for (size_t vertex = first; vertex < last; ++vertex) {
+                        if ((visited[vertex / wordBits].load(memory_order_relaxed) >> (vertex % wordBits)) & 1U) {
+                            continue;
+                        }
+                        for (size_t edge = incoming.offsets[vertex]; edge < incoming.offsets[vertex + 1]; ++edge) {
+                            size_t parent = incoming.neighbors[edge];
+                            if ((frontierBits[parent / wordBits] >> (parent % wordBits)) & 1U) {
+                                claim(vertex);
+                                local.push_back(vertex);
+                                break;
+                            }
+                        }
+                    }
+                    mergeLocal(local);
+                });
+            } else {
+                pool.parallelFor(0, frontier.size(), [&](size_t first, size_t last) {
+                    vector<size_t> local;
+                    for (size_t i = first; i < last; ++i) {
+                        size_t vertex = frontier[i];
+                        for (size_t edge = outgoing.offsets[vertex]; edge < outgoing.offsets[vertex + 1]; ++edge) {
+                            if (claim(outgoing.neighbors[edge])) {
+                                local.push_back(outgoing.neighbors[edge]);
+                            }
+                        }
+                    }
+                    mergeLocal(local);
+                });
+            }
+
+            reached += nextFrontier.size();
+            for (size_t vertex : nextFrontier) {
+                unexploredEdges -= outDegree(vertex);
+            }
+            frontier.swap(nextFrontier);
+        }
+        return reached == adjSize;
+    }
+
+    // Word-parallel BFS 2-coloring with one bitset per side: a vertex conflicts when its row
+    // intersects its own side, and its uncolored neighbors join the other side in one OR.
+    // Fills colors with 0/1 and returns false on the first conflict.
+    bool colorBipartiteBitParallel(const BitMatrix& bits, vector<int>& colors) {
+        size_t words = bits.getWordsPerRow();
+        vector<uint64_t> sides[2] = {vector<uint64_t>(words, 0), vector<uint64_t>(words, 0)};
+        vector<size_t> frontier;
+        vector<size_t> nextFrontier;
+
+        for (size_t i = 0; i < colors.size(); ++i) {
+            if (colors[i] != -1) {
+                continue;
+            }
+            colors[i] = 0;
+            sides[0][i / BitMatrix::WORD_BITS] |= uint64_t(1) << (i % BitMatrix::WORD_BITS);
+            frontier.assign(1, i);
+
+            while (!frontier.empty()) {
+                nextFrontier.clear();
+                for (size_t vertex : frontier) {
+                    size_t color = static_cast<size_t>(colors[vertex]);
+                    const vector<uint64_t>& same = sides[color];
+                    vector<uint64_t>& other = sides[1 - color];
+                    const uint64_t* row = bits.row(vertex);
+                    size_t firstNew = nextFrontier.size();
+                    for (size_t w = 0; w < words; ++w) {
+                        if ((row[w] & same[w]) != 0) {
+                            return false;
+                        }
+                        uint64_t fresh = row[w] & ~(same[w] | other[w]);
+                        other[w] |= fresh;
+                        appendSetBits(fresh, w, nextFrontier);
+                    }
+                    for (size_t k = firstNew; k < nextFrontier.size(); ++k) {
+                        colors[nextFrontier[k]] = 1 - colors[vertex];
+                    }
+                }
+                frontier.swap(nextFrontier);
+            }
+        }
+        return true;
+    }
+
+    // Tile edge for the blocked Floyd-Warshall; a distance tile and a next-hop tile fit in L1/L2
+    const size_t FLOYD_WARSHALL_BLOCK = 64;
+
+    // Smallest graph whose Floyd-Warshall phase 3 is split across threads
+    const size_t PARALLEL_FLOYD_WARSHALL_MIN_VERTICES = 128;
+
+    // Relax the tile rows [iBegin, iEnd) x cols [jBegin, jEnd) through the intermediates [kBegin, kEnd).
+    // k is the outermost loop, so tiles that overlap the k block (phases 1 and 2) stay correct.
+    template <typename Weight>
+    void relaxTile(vector<Weight>& distances, vector<size_t>& nextHop, size_t n,
+                   size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd, size_t kBegin, size_t kEnd) {
+        typedef typename Relaxation<Weight>::Distance Distance;
+        const Distance lowest = numeric_limits<Weight>::lowest();
+        for (size_t k = kBegin; k < kEnd; ++k) {
+            const Weight* kRow = distances.data() + k * n;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                Weight* iRow = distances.data() + i * n;
+                Weight ik = iRow[k];
+                if (ik == infinity<Weight>()) {
+                    continue;
+                }
+                size_t hop = nextHop[i * n + k];
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    Distance through = Relaxation<Weight>::add(ik, kRow[j]);
+                    if (kRow[j] != infinity<Weight>() && through < iRow[j]) {
+                        iRow[j] = through < lowest ? numeric_limits<Weight>::lowest() : static_cast<Weight>(through);
+                        nextHop[i * n + j] = hop;
+                    }
+                }
+            }
+        }
+    }
+
     bool allVisited(const vector<bool>& visited) {
         return all_of(visited.begin(), visited.end(), [](bool visitedFlag) { return visitedFlag; });
     }
 
-    void addToPath(string& path, size_t current) {
-        if (!path.empty()) {
-            path.insert(0, "->");
+    // Format vertices as "a->b->c"
+    string joinVertices(const vector<size_t>& vertices) {
+        string joined;
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            if (i != 0) {
+                joined += "->";
+            }
+            joined += to_string(vertices[i]);
+        }
+        return joined;
+    }
+
+    // Format vertices as "a, b, c"
+    string listVertices(const vector<size_t>& vertices) {
+        string listed;
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            if (i != 0) {
+                listed += ", ";
+            }
+            listed += to_string(vertices[i]);
+        }
+        return listed;
+    }
+
+    // Collect the parent chain ending at last into path, from its root down to last.
+    // Returns false, with path empty, if the chain runs past V vertices: it loops through a cycle.
+    bool tracePath(const vector<size_t>& parent, size_t last, vector<size_t>& path) {
+        path.clear();
+        for (size_t current = last; current != UNDEFINED_SIZE_T; current = parent[current]) {
+            if (path.size() == parent.size()) {
+                path.clear();
+                return false;
+            }
+            path.push_back(current);
         }
-        path.insert(0, to_string(current));
+        reverse(path.begin(), path.end());
+        return true;
     }
 
-    void addToCycle(string& cycle, size_t current) {
-        if (!cycle.empty()) {
-            cycle.insert(0, "->");
+    // Mark every vertex reachable from the marked ones
+    template <typename Weight>
+    void markReachable(const BasicGraph<Weight>& graph, vector<bool>& marked) {
+        vector<size_t> pending;
+        for (size_t v = 0; v < marked.size(); ++v) {
+            if (marked[v]) {
+                pending.push_back(v);
+            }
+        }
+        while (!pending.empty()) {
+            size_t src = pending.back();
+            pending.pop_back();
+            forEachNeighbor(graph, src, [&](size_t dest, Weight /*weight*/) {
+                if (!marked[dest]) {
+                    marked[dest] = true;
+                    pending.push_back(dest);
+                }
+                return true;
+            });
         }
-        cycle.insert(0, to_string(current));
     }
 
-    bool containsNegativeCycle(size_t adjSize, const vector<vector<int>>& adjMatrix, vector<int>& distances) {
+    // Round-based Bellman-Ford that stops after the first round without a relaxation.
+    // Returns true if a negative cycle is reachable from the finite-distance vertices; unbounded
+    // then marks the vertices such a cycle reaches, which have no shortest path.
+    template <typename Weight>
+    bool bellmanFord(const BasicGraph<Weight>& graph, vector<typename Relaxation<Weight>::Distance>& distances, vector<size_t>& parent, vector<bool>& unbounded) {
+        typedef typename Relaxation<Weight>::Distance Distance;
+        size_t adjSize = distances.size();
+        vector<size_t> pathEdges(adjSize, 0);
+        unbounded.assign(adjSize, false);
+        // Rounds 0 .. V-2 settle every shortest path; a relaxation in round V-1 proves a negative cycle.
+        // Every reachable negative cycle has a vertex relaxed in that round, so whatever those
+        // vertices reach covers every vertex without a shortest path.
         for (size_t i = 0; i < adjSize; ++i) {
+            bool changed = false;
+            bool lastRound = i + 1 == adjSize;
             for (size_t src = 0; src < adjSize; ++src) {
-                for (size_t dest = 0; dest < adjSize; ++dest) {
-                    if (adjMatrix[src][dest] != 0 && distances[src] + adjMatrix[src][dest] < distances[dest]) {
-                        if (i == adjSize - 1) {
-                            return true;
+                if (distances[src] == Relaxation<Weight>::unreachable()) {
+                    continue;
+                }
+                forEachNeighbor(graph, src, [&](size_t dest, Weight weight) {
+                    Distance through = Relaxation<Weight>::add(distances[src], weight);
+                    if (through < distances[dest] || (Relaxation<Weight>::saturated(through) && pathEdges[src] + 1 > pathEdges[dest])) {
+                        distances[dest] = through;
+                        parent[dest] = src;
+                        pathEdges[dest] = pathEdges[src] + 1;
+                        changed = true;
+                        if (lastRound) {
+                            unbounded[dest] = true;
                         }
-                        distances[dest] = distances[src] + adjMatrix[src][dest];
                     }
-                }
+                    return true;
+                });
+            }
+            if (!changed) {
+                return false;
             }
         }
-        return false;
+        markReachable(graph, unbounded);
+        return true;
     }
 
-    void processVertexQueue(size_t vertex, const vector<vector<int>>& adjMatrix, vector<int>& colors, queue<size_t>& vertexQueue) {
-        for (size_t j = 0; j < adjMatrix.size(); ++j) {
-            if (adjMatrix[vertex][j] != 0) {
-                if (colors[j] == -1) {
-                    colors[j] = 1 - colors[vertex];
-                    vertexQueue.push(j);
-                } else if (colors[j] == colors[vertex]) {
-                    throw runtime_error("Graph is not bipartite");
+    // Queue-based Bellman-Ford (SPFA): only vertices whose distance just improved are rescanned.
+    // Every finite-distance vertex starts in the queue. Once some shortest path would need V edges,
+    // which only a negative cycle allows, the parent pointers are walked back from that vertex; if
+    // they close a loop (always a negative cycle) the search stops, leaving distances and parent
+    // partially relaxed. Returns a vertex on that loop, or UNDEFINED_SIZE_T if there is no
+    // negative cycle.
+    template <typename Weight>
+    size_t spfa(const BasicGraph<Weight>& graph, vector<typename Relaxation<Weight>::Distance>& distances, vector<size_t>& parent) {
+        typedef typename Relaxation<Weight>::Distance Distance;
+        size_t adjSize = distances.size();
+        queue<size_t> pending;
+        vector<bool> queued(adjSize, false);
+        vector<size_t> pathEdges(adjSize, 0);
+        vector<size_t> walkMark(adjSize, 0); // Stamp of the last parent walk through each vertex
+        size_t walkStamp = 0;
+        size_t onCycle = UNDEFINED_SIZE_T;
+
+        for (size_t v = 0; v < adjSize; ++v) {
+            if (distances[v] != Relaxation<Weight>::unreachable()) {
+                pending.push(v);
+                queued[v] = true;
+            }
+        }
+
+        while (!pending.empty()) {
+            size_t src = pending.front();
+            pending.pop();
+            queued[src] = false;
+
+            bool negativeCycle = !forEachNeighbor(graph, src, [&](size_t dest, Weight weight) {
+                Distance through = Relaxation<Weight>::add(distances[src], weight);
+                if (through < distances[dest] || (Relaxation<Weight>::saturated(through) && pathEdges[src] + 1 > pathEdges[dest])) {
+                    distances[dest] = through;
+                    parent[dest] = src;
+                    pathEdges[dest] = pathEdges[src] + 1;
+                    if (pathEdges[dest] >= adjSize) {
+                        // The parent pointers may still lead back to a source; relaxing goes on
+                        // until they close the loop
+                        ++walkStamp;
+                        for (size_t current = dest; current != UNDEFINED_SIZE_T; current = parent[current]) {
+                            if (walkMark[current] == walkStamp) {
+                                onCycle = current;
+                                return false;
+                            }
+                            walkMark[current] = walkStamp;
+                        }
+                    }
+                    if (!queued[dest]) {
+                        pending.push(dest);
+                        queued[dest] = true;
+                    }
                 }
+                return true;
+            });
+            if (negativeCycle) {
+                return onCycle;
             }
         }
+        return UNDEFINED_SIZE_T;
     }
 
-    void populateBipartiteSets(const vector<int>& colors, string& result) {
-        bool first = true;
-        for (size_t i = 0; i < colors.size(); ++i) {
-            if (colors[i] == 0) {
-                if (!first) {
-                    result += ", ";
+    // Binary-heap Dijkstra; only valid for non-negative weights. Stops once end is settled.
+    template <typename Weight>
+    void dijkstra(const BasicGraph<Weight>& graph, size_t start, size_t end, vector<typename Relaxation<Weight>::Distance>& distances, vector<size_t>& parent) {
+        typedef typename Relaxation<Weight>::Distance Distance;
+        typedef pair<Distance, size_t> QueueEntry; // (distance, vertex)
+        priority_queue<QueueEntry, vector<QueueEntry>, greater<QueueEntry>> frontier;
+        vector<bool> settled(distances.size(), false);
+        frontier.push(QueueEntry(distances[start], start));
+
+        while (!frontier.empty()) {
+            size_t src = frontier.top().second;
+            frontier.pop();
+            if (settled[src]) {
+                continue; // Stale entry left behind by a later improvement
+            }
+            settled[src] = true;
+            if (src == end) {
+                return;
+            }
+            forEachNeighbor(graph, src, [&](size_t dest, Weight weight) {
+                Distance through = Relaxation<Weight>::add(distances[src], weight);
+                if (!settled[dest] && through < distances[dest]) {
+                    distances[dest] = through;
+                    parent[dest] = src;
+                    frontier.push(QueueEntry(distances[dest], dest));
                 }
-                result += to_string(i);
-                first = false;
+                return true;
+            });
+        }
+    }
+
+    // Dijkstra from start over outgoing edges and from end over incoming edges, expanding the
+    // smaller frontier each step. Every edge scanned between the two trees offers a start -> end
+    // route; the search stops once the two frontier minimums together cannot beat the best one.
+    template <typename Weight>
+    PathResult bidirectionalDijkstra(const BasicGraph<Weight>& graph, size_t start, size_t end) {
+        typedef typename Relaxation<Weight>::Distance Distance;
+        typedef pair<Distance, size_t> QueueEntry; // (distance, vertex)
+        typedef priority_queue<QueueEntry, vector<QueueEntry>, greater<QueueEntry>> Frontier;
+
+        size_t adjSize = vertexCount(graph);
+        // Side 0 searches forward from start, side 1 backward from end; parent[1] links toward end
+        vector<Distance> distances[2] = {vector<Distance>(adjSize, Relaxation<Weight>::unreachable()), vector<Distance>(adjSize, Relaxation<Weight>::unreachable())};
+        vector<size_t> parent[2] = {vector<size_t>(adjSize, UNDEFINED_SIZE_T), vector<size_t>(adjSize, UNDEFINED_SIZE_T)};
+        vector<bool> settled[2] = {vector<bool>(adjSize, false), vector<bool>(adjSize, false)};
+        Frontier frontier[2];
+        distances[0][start] = 0;
+        distances[1][end] = 0;
+        frontier[0].push(QueueEntry(0, start));
+        frontier[1].push(QueueEntry(0, end));
+
+        // The best route found so far crosses the edge meetFrom -> meetTo (or is the single vertex start == end)
+        Distance best = start == end ? 0 : Relaxation<Weight>::unreachable();
+        size_t meetFrom = UNDEFINED_SIZE_T;
+        size_t meetTo = UNDEFINED_SIZE_T;
+
+        // An exhausted side has offered every route through its tree, so best is final
+        while (!frontier[0].empty() && !frontier[1].empty()) {
+            if (Relaxation<Weight>::add(frontier[0].top().first, frontier[1].top().first) >= best) {
+                break;
+            }
+            size_t side = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+            size_t other = 1 - side;
+            size_t src = frontier[side].top().second;
+            frontier[side].pop();
+            if (settled[side][src]) {
+                continue; // Stale entry left behind by a later improvement
+            }
+            settled[side][src] = true;
+
+            auto relax = [&](size_t dest, Weight weight) {
+                Distance reached = Relaxation<Weight>::add(distances[side][src], weight);
+                if (!settled[side][dest] && reached < distances[side][dest]) {
+                    distances[side][dest] = reached;
+                    parent[side][dest] = src;
+                    frontier[side].push(QueueEntry(distances[side][dest], dest));
+                }
+                if (distances[other][dest] != Relaxation<Weight>::unreachable()) {
+                    Distance through = Relaxation<Weight>::add(reached, distances[other][dest]);
+                    if (through < best) {
+                        best = through;
+                        meetFrom = side == 0 ? src : dest;
+                        meetTo = side == 0 ? dest : src;
+                    }
+                }
+                return true;
+            };
+            if (side == 0) {
+                forEachNeighbor(graph, src, relax);
+            } else {
+                forEachPredecessor(graph, src, relax);
             }
         }
-        result += "}, B={";
-        first = true;
-        for (size_t i = 0; i < colors.size(); ++i) {
-            if (colors[i] == 1) {
-                if (!first) {
-                    result += ", ";
+
+        PathResult result;
+        result.found = best != Relaxation<Weight>::unreachable();
+        if (!result.found) {
+            return result;
+        }
+        if (meetFrom == UNDEFINED_SIZE_T) {
+            result.vertices.push_back(start);
+            return result;
+        }
+        result.found = tracePath(parent[0], meetFrom, result.vertices);
+        if (!result.found) {
+            return result;
+        }
+        for (size_t current = meetTo; current != UNDEFINED_SIZE_T; current = parent[1][current]) {
+            result.vertices.push_back(current);
+        }
+        return result;
+    }
+
+    // A* with lazy deletion: an improved vertex is pushed again rather than decreased in place, and
+    // settled vertices may be reopened, so an admissible heuristic need not also be consistent.
+    template <typename Weight>
+    PathResult aStar(const BasicGraph<Weight>& graph, size_t start, size_t end, const typename BasicDistanceHeuristic<Weight>::type& heuristic) {
+        typedef typename Relaxation<Weight>::Distance Distance;
+        struct QueueEntry {
+            Distance priority; // distance + heuristic
+            Distance distance;
+            size_t vertex;
+            bool operator>(const QueueEntry& other) const { return priority > other.priority; }
+        };
+        priority_queue<QueueEntry, vector<QueueEntry>, greater<QueueEntry>> frontier;
+
+        size_t adjSize = vertexCount(graph);
+        vector<Distance> distances(adjSize, Relaxation<Weight>::unreachable());
+        vector<size_t> parent(adjSize, UNDEFINED_SIZE_T);
+        distances[start] = 0;
+        frontier.push(QueueEntry{heuristic(start), 0, start});
+
+        PathResult result;
+        result.found = false;
+        while (!frontier.empty()) {
+            QueueEntry entry = frontier.top();
+            frontier.pop();
+            if (entry.distance > distances[entry.vertex]) {
+                continue; // Stale entry left behind by a later improvement
+            }
+            size_t src = entry.vertex;
+            if (src == end) {
+                result.found = tracePath(parent, end, result.vertices);
+                break;
+            }
+            forEachNeighbor(graph, src, [&](size_t dest, Weight weight) {
+                Distance through = Relaxation<Weight>::add(distances[src], weight);
+                if (through < distances[dest]) {
+                    distances[dest] = through;
+                    parent[dest] = src;
+                    frontier.push(QueueEntry{Relaxation<Weight>::add(through, heuristic(dest)), through, dest});
                 }
-                result += to_string(i);
-                first = false;
+                return true;
+            });
+        }
+        return result;
+    }
+
+    // Distance and parent buffers of one single-source solve, reused across solves
+    template <typename Weight>
+    struct SingleSourceScratch {
+        vector<typename Relaxation<Weight>::Distance> distances;
+        vector<size_t> parent;
+        vector<bool> unbounded; // After a negative cycle: the vertices it reaches, which have no shortest path
+    };
+
+    template <typename Weight>
+    ShortestPathMode resolveMode(const BasicGraph<Weight>& graph, ShortestPathMode mode) {
+        if (mode == ShortestPathMode::Auto) {
+            // The graph counts its negative cells as they change, so Auto costs no scan
+            return graph.hasNegativeWeight() ? ShortestPathMode::Spfa : ShortestPathMode::Dijkstra;
+        }
+        return mode;
+    }
+
+    // Run the engine picked by a resolved mode from start; Dijkstra may stop once end is settled
+    // (pass UNDEFINED_SIZE_T to solve every vertex). The point-to-point BidirectionalDijkstra
+    // falls back to Dijkstra here. Returns true if a negative cycle was found; SPFA stops at the first
+    // one it closes, so the round-based solve then reruns to mark every vertex left unbounded.
+    template <typename Weight>
+    bool solveSingleSource(const BasicGraph<Weight>& graph, size_t start, size_t end, ShortestPathMode mode, SingleSourceScratch<Weight>& scratch) {
+        size_t adjSize = vertexCount(graph);
+        scratch.distances.assign(adjSize, Relaxation<Weight>::unreachable());
+        scratch.parent.assign(adjSize, UNDEFINED_SIZE_T);
+        scratch.distances[start] = 0;
+
+        if (mode == ShortestPathMode::Dijkstra || mode == ShortestPathMode::BidirectionalDijkstra) {
+            dijkstra(graph, start, end, scratch.distances, scratch.parent);
+            return false;
+        }
+        if (mode == ShortestPathMode::Spfa) {
+            if (spfa(graph, scratch.distances, scratch.parent) == UNDEFINED_SIZE_T) {
+                return false;
             }
+            scratch.distances.assign(adjSize, Relaxation<Weight>::unreachable());
+            scratch.parent.assign(adjSize, UNDEFINED_SIZE_T);
+            scratch.distances[start] = 0;
         }
-        result += "}.";
+        return bellmanFord(graph, scratch.distances, scratch.parent, scratch.unbounded);
+    }
+
+    template <typename Weight>
+    PathResult pathTo(const SingleSourceScratch<Weight>& scratch, size_t end, bool negativeCycle) {
+        PathResult result;
+        // Vertices a reachable negative cycle leads to have no finite shortest length
+        result.found = !(negativeCycle && scratch.unbounded[end]) && scratch.distances[end] != Relaxation<Weight>::unreachable();
+        if (result.found) {
+            result.found = tracePath(scratch.parent, end, result.vertices);
+        }
+        return result;
     }
-}
 
-void Algorithms::dfs(const Graph& graph, size_t vertex, vector<bool>& visited, vector<size_t>& parent, bool& hasCycle, size_t& cycleStart, size_t& cycleEnd) {
-    visited[vertex] = true;
-    const auto& adjMatrix = graph.getAdjacencyMatrix();
-    for (size_t i = 0; i < adjMatrix.size(); ++i) {
-        if (adjMatrix[vertex][i] != 0) {
-            if (!visited[i]) {
-                parent[i] = vertex;
-                dfs(graph, i, visited, parent, hasCycle, cycleStart, cycleEnd);
-                if (hasCycle) {
+    // Iterative Tarjan: calls emit(component) for every strongly connected component, sorted by
+    // vertex, in reverse topological order. Stops early as soon as emit returns false.
+    template <typename Weight, typename Emit>
+    void forEachStrongComponent(const BasicGraph<Weight>& graph, Emit emit) {
+        size_t adjSize = vertexCount(graph);
+        vector<size_t> order(adjSize, UNDEFINED_SIZE_T); // Discovery index
+        vector<size_t> low(adjSize, 0);                  // Smallest discovery index reachable through the DFS subtree
+        vector<bool> onStack(adjSize, false);
+        vector<size_t> pending;                          // Vertices not yet assigned to a component
+        vector<pair<size_t, size_t>> stack;              // (vertex, next edge cursor) frames
+        vector<size_t> component;
+        size_t counter = 0;
+
+        for (size_t root = 0; root < adjSize; ++root) {
+            if (order[root] != UNDEFINED_SIZE_T) {
+                continue;
+            }
+            order[root] = low[root] = counter++;
+            pending.push_back(root);
+            onStack[root] = true;
+            stack.push_back(make_pair(root, size_t(0)));
+
+            while (!stack.empty()) {
+                size_t vertex = stack.back().first;
+                size_t next = 0;
+                if (nextNeighbor(graph, vertex, stack.back().second, next)) {
+                    if (order[next] == UNDEFINED_SIZE_T) {
+                        order[next] = low[next] = counter++;
+                        pending.push_back(next);
+                        onStack[next] = true;
+                        stack.push_back(make_pair(next, size_t(0)));
+                    } else if (onStack[next]) {
+                        low[vertex] = min(low[vertex], order[next]);
+                    }
+                    continue;
+                }
+
+                stack.pop_back();
+                if (!stack.empty()) {
+                    size_t caller = stack.back().first;
+                    low[caller] = min(low[caller], low[vertex]);
+                }
+                if (low[vertex] != order[vertex]) {
+                    continue;
+                }
+                // vertex roots a component: everything pushed after it belongs to it
+                component.clear();
+                size_t member = UNDEFINED_SIZE_T;
+                while (member != vertex) {
+                    member = pending.back();
+                    pending.pop_back();
+                    onStack[member] = false;
+                    component.push_back(member);
+                }
+                sort(component.begin(), component.end());
+                if (!emit(component)) {
                     return;
                 }
-            } else if (i != parent[vertex]) {
-                hasCycle = true;
-                cycleStart = i;
-                cycleEnd = vertex;
-                return;
             }
         }
     }
+
+    // Color the uncolored neighbors of vertex and append them to the BFS queue.
+    // Returns false if a neighbor already has the same color as vertex.
+    template <typename Weight>
+    bool processVertexQueue(size_t vertex, const BasicGraph<Weight>& graph, vector<int>& colors, vector<size_t>& vertexQueue) {
+        return forEachNeighbor(graph, vertex, [&](size_t j, Weight /*weight*/) {
+            if (colors[j] == -1) {
+                colors[j] = 1 - colors[vertex];
+                vertexQueue.push_back(j);
+            } else if (colors[j] == colors[vertex]) {
+                return false;
+            }
+            return true;
+        });
+    }
+
 }
 
-bool Algorithms::isConnected(const Graph& graph) {
-    const auto& adjMatrix = graph.getAdjacencyMatrix();
-    vector<bool> visited(adjMatrix.size(), false);
+template <typename Weight>
+void Algorithms::dfs(const BasicGraph<Weight>& graph, size_t root, vector<bool>& visited, vector<size_t>& parent, bool& hasCycle, size_t& cycleStart, size_t& cycleEnd, DfsStack& stack) {
+    stack.clear();
+    visited[root] = true;
+    stack.push_back(make_pair(root, size_t(0)));
+
+    while (!stack.empty()) {
+        size_t vertex = stack.back().first;
+        size_t next = 0;
+        if (!nextNeighbor(graph, vertex, stack.back().second, next)) {
+            stack.pop_back();
+            continue;
+        }
+        if (!visited[next]) {
+            parent[next] = vertex;
+            visited[next] = true;
+            stack.push_back(make_pair(next, size_t(0)));
+        } else if (next != parent[vertex]) {
+            hasCycle = true;
+            cycleStart = next;
+            cycleEnd = vertex;
+            return;
+        }
+    }
+}
+
+template <typename Weight>
+bool Algorithms::directedDfs(const BasicGraph<Weight>& graph, size_t root, vector<int>& colors, vector<size_t>& parent, size_t& cycleStart, size_t& cycleEnd, DfsStack& stack) {
+    stack.clear();
+    colors[root] = 1;
+    stack.push_back(make_pair(root, size_t(0)));
+
+    while (!stack.empty()) {
+        size_t vertex = stack.back().first;
+        size_t next = 0;
+        if (!nextNeighbor(graph, vertex, stack.back().second, next)) {
+            colors[vertex] = 2;
+            stack.pop_back();
+            continue;
+        }
+        if (colors[next] == 0) {
+            parent[next] = vertex;
+            colors[next] = 1;
+            stack.push_back(make_pair(next, size_t(0)));
+        } else if (colors[next] == 1) {
+            // A back edge to a vertex still on the stack closes a cycle
+            cycleStart = next;
+            cycleEnd = vertex;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Weight>
+bool Algorithms::isConnected(const BasicGraph<Weight>& graph, GraphKind kind) {
+    TraversalScratch scratch;
+    return isConnected(graph, scratch, kind);
+}
+
+template <typename Weight>
+bool Algorithms::isConnected(const BasicGraph<Weight>& graph, TraversalScratch& scratch, GraphKind kind) {
+    vector<bool>& visited = scratch.visited;
+    visited.assign(vertexCount(graph), false);
+    if (visited.empty()) {
+        return true;
+    }
+
+    // One Tarjan pass: the first component completed must already hold every vertex
+    if (kind == GraphKind::Directed) {
+        bool strong = false;
+        forEachStrongComponent(graph, [&](const vector<size_t>& component) {
+            strong = component.size() == visited.size();
+            return false;
+        });
+        return strong;
+    }
+
+    // A tracked graph keeps its component count current, so no traversal is needed. The components
+    // ignore edge direction, so they answer only when every edge also runs the other way.
+    if (graph.tracksConnectivity() && graph.isSymmetric()) {
+        return graph.getComponents().count() == 1;
+    }
+
+    // Dense graphs expand whole bit rows at a time instead of scanning cells
+    if (!graph.isSparse()) {
+        return isConnectedBitParallel(graph.getBitMatrix());
+    }
+
+    if (visited.size() >= PARALLEL_BFS_MIN_VERTICES) {
+        return isConnectedParallelBfs(graph);
+    }
 
     // Perform DFS starting from vertex 0
-    dfs1(graph, 0, visited);
+    dfs1(graph, 0, visited, scratch.stack);
 
     // Check if all vertices are visited using helper function
     return allVisited(visited);
 }
 
-string Algorithms::shortestPath(const Graph& graph, size_t start, size_t end) {
-    const auto& adjMatrix = graph.getAdjacencyMatrix();
-    vector<int> distances(adjMatrix.size(), INFINITY_INT);
-    vector<size_t> parent(adjMatrix.size(), UNDEFINED_SIZE_T);
-    distances[start] = 0;
+template <typename Weight>
+PathResult Algorithms::findShortestPath(const BasicGraph<Weight>& graph, size_t start, size_t end, ShortestPathMode mode) {
+    if (mode == ShortestPathMode::BidirectionalDijkstra) {
+        return bidirectionalDijkstra(graph, start, end);
+    }
+    SingleSourceScratch<Weight> scratch;
+    bool negativeCycle = solveSingleSource(graph, start, end, resolveMode(graph, mode), scratch);
+    return pathTo(scratch, end, negativeCycle);
+}
 
-    for (size_t i = 0; i < adjMatrix.size() - 1; ++i) {
-        for (size_t src = 0; src < adjMatrix.size(); ++src) {
-            for (size_t dest = 0; dest < adjMatrix.size(); ++dest) {
-                if (adjMatrix[src][dest] != 0 && distances[src] != INFINITY_INT && distances[src] + adjMatrix[src][dest] < distances[dest]) {
-                    distances[dest] = distances[src] + adjMatrix[src][dest];
-                    parent[dest] = src;
-                }
-            }
-        }
+template <typename Weight>
+vector<PathResult> Algorithms::findShortestPaths(const BasicGraph<Weight>& graph, const vector<pair<size_t, size_t>>& queries, ShortestPathMode mode) {
+    vector<PathResult> results(queries.size());
+    if (queries.empty()) {
+        return results;
     }
+    // The weight scan behind Auto runs once for the whole batch
+    mode = resolveMode(graph, mode);
 
-    if (distances[end] == INFINITY_INT) {
-        return "-1";
+    // Group the queries by source: order lists them source by source, groupStarts marks each source's run
+    vector<size_t> order(queries.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    stable_sort(order.begin(), order.end(), [&](size_t left, size_t right) { return queries[left].first < queries[right].first; });
+    vector<size_t> groupStarts;
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i == 0 || queries[order[i]].first != queries[order[i - 1]].first) {
+            groupStarts.push_back(i);
+        }
     }
+    groupStarts.push_back(order.size());
 
-    string path;
-    size_t current = end;
-    while (current != UNDEFINED_SIZE_T) {
-        addToPath(path, current);
-        current = parent[current];
+    // One single-source solve per distinct source, spread across the pool; each chunk reuses one scratch
+    ThreadPool::shared().parallelFor(0, groupStarts.size() - 1, [&](size_t firstGroup, size_t lastGroup) {
+        SingleSourceScratch<Weight> scratch;
+        for (size_t group = firstGroup; group < lastGroup; ++group) {
+            size_t source = queries[order[groupStarts[group]]].first;
+            bool negativeCycle = solveSingleSource(graph, source, UNDEFINED_SIZE_T, mode, scratch);
+            for (size_t q = groupStarts[group]; q < groupStarts[group + 1]; ++q) {
+                results[order[q]] = pathTo(scratch, queries[order[q]].second, negativeCycle);
+            }
+        }
+    });
+    return results;
+}
+
+template <typename Weight>
+vector<string> Algorithms::shortestPaths(const BasicGraph<Weight>& graph, const vector<pair<size_t, size_t>>& queries, ShortestPathMode mode) {
+    vector<PathResult> results = findShortestPaths(graph, queries, mode);
+    vector<string> paths;
+    paths.reserve(results.size());
+    for (const PathResult& result : results) {
+        paths.push_back(result.found ? joinVertices(result.vertices) : "-1");
     }
+    return paths;
+}
+
+template <typename Weight>
+string Algorithms::shortestPath(const BasicGraph<Weight>& graph, size_t start, size_t end, ShortestPathMode mode) {
+    PathResult result = findShortestPath(graph, start, end, mode);
+    return result.found ? joinVertices(result.vertices) : "-1";
+}
 
-    return path;
+template <typename Weight>
+PathResult Algorithms::findShortestPathAStar(const BasicGraph<Weight>& graph, size_t start, size_t end, const typename BasicDistanceHeuristic<Weight>::type& heuristic) {
+    return aStar(graph, start, end, heuristic);
 }
 
-string Algorithms::isBipartite(const Graph& graph) {
-    const auto& adjMatrix = graph.getAdjacencyMatrix();
-    vector<int> colors(adjMatrix.size(), -1);
+template <typename Weight>
+string Algorithms::shortestPathAStar(const BasicGraph<Weight>& graph, size_t start, size_t end, const typename BasicDistanceHeuristic<Weight>::type& heuristic) {
+    PathResult result = findShortestPathAStar(graph, start, end, heuristic);
+    return result.found ? joinVertices(result.vertices) : "-1";
+}
 
-    try {
-        for (size_t i = 0; i < adjMatrix.size(); ++i) {
-            if (colors[i] == -1) {
-                colors[i] = 0;
-                queue<size_t> vertexQueue;
-                vertexQueue.push(i);
+template <typename Weight>
+BipartiteResult Algorithms::findBipartition(const BasicGraph<Weight>& graph) {
+    vector<int> colors(vertexCount(graph), -1);
+    BipartiteResult result;
+    result.bipartite = false;
 
-                while (!vertexQueue.empty()) {
-                    size_t vertex = vertexQueue.front();
-                    vertexQueue.pop();
-                    processVertexQueue(vertex, adjMatrix, colors, vertexQueue);
+    // Dense graphs color 64 vertices per word with bit rows instead of scanning cells
+    if (!graph.isSparse()) {
+        if (!colorBipartiteBitParallel(graph.getBitMatrix(), colors)) {
+            return result;
+        }
+    } else {
+        // One queue for every component: each vertex is appended once, so head never passes V
+        vector<size_t> vertexQueue;
+        vertexQueue.reserve(colors.size());
+        for (size_t i = 0; i < colors.size(); ++i) {
+            if (colors[i] != -1) {
+                continue;
+            }
+            colors[i] = 0;
+            vertexQueue.push_back(i);
+            for (size_t head = vertexQueue.size() - 1; head < vertexQueue.size(); ++head) {
+                if (!processVertexQueue(vertexQueue[head], graph, colors, vertexQueue)) {
+                    return result;
                 }
             }
         }
-    } catch (const runtime_error&) {
-        return "0";
     }
 
-    string result = "The graph is bipartite: A={";
-    populateBipartiteSets(colors, result);
-
+    result.bipartite = true;
+    for (size_t i = 0; i < colors.size(); ++i) {
+        (colors[i] == 0 ? result.sideA : result.sideB).push_back(i);
+    }
     return result;
 }
 
-void Algorithms::dfs1(const Graph& graph, size_t vertex, vector<bool>& visited) {
-    visited[vertex] = true;
-    const auto& adjMatrix = graph.getAdjacencyMatrix();
-    for (size_t i = 0; i < adjMatrix.size(); ++i) {
-        if (adjMatrix[vertex][i] != 0 && !visited[i]) {
-            dfs1(graph, i, visited);
+template <typename Weight>
+string Algorithms::isBipartite(const BasicGraph<Weight>& graph) {
+    BipartiteResult result = findBipartition(graph);
+    if (!result.bipartite) {
+        return "0";
+    }
+    return "The graph is bipartite: A={" + listVertices(result.sideA) + "}, B={" + listVertices(result.sideB) + "}.";
+}
+
+template <typename Weight>
+void Algorithms::dfs1(const BasicGraph<Weight>& graph, size_t root, vector<bool>& visited, DfsStack& stack) {
+    stack.clear();
+    visited[root] = true;
+    stack.push_back(make_pair(root, size_t(0)));
+
+    while (!stack.empty()) {
+        size_t next = 0;
+        if (!nextNeighbor(graph, stack.back().first, stack.back().second, next)) {
+            stack.pop_back();
+        } else if (!visited[next]) {
+            visited[next] = true;
+            stack.push_back(make_pair(next, size_t(0)));
         }
     }
 }
 
-string Algorithms::isContainsCycle(const Graph& graph) {
-    const auto& adjMatrix = graph.getAdjacencyMatrix();
-    vector<bool> visited(adjMatrix.size(), false);
-    vector<size_t> parent(adjMatrix.size(), UNDEFINED_SIZE_T);
+template <typename Weight>
+PathResult Algorithms::findCycle(const BasicGraph<Weight>& graph, GraphKind kind) {
+    TraversalScratch scratch;
+    return findCycle(graph, scratch, kind);
+}
+
+template <typename Weight>
+PathResult Algorithms::findCycle(const BasicGraph<Weight>& graph, TraversalScratch& scratch, GraphKind kind) {
+    size_t adjSize = vertexCount(graph);
+    vector<bool>& visited = scratch.visited;
+    vector<int>& colors = scratch.colors;
+    vector<size_t>& parent = scratch.parent;
+    DfsStack& stack = scratch.stack;
+    visited.assign(adjSize, false);
+    colors.assign(adjSize, 0);
+    parent.assign(adjSize, UNDEFINED_SIZE_T);
     bool hasCycle = false;
     size_t cycleStart = UNDEFINED_SIZE_T;
     size_t cycleEnd = UNDEFINED_SIZE_T;
 
-    for (size_t i = 0; i < adjMatrix.size(); ++i) {
-        if (!visited[i]) {
-            dfs(graph, i, visited, parent, hasCycle, cycleStart, cycleEnd);
-            if (hasCycle) {
-                string cycle;
-                size_t current = cycleEnd;
-                while (current != cycleStart) {
-                    addToCycle(cycle, current);
-                    current = parent[current];
-                }
-                cycle.insert(0, to_string(cycleStart) + "->");
-                cycle += to_string(cycleStart);
-                return cycle;
+    for (size_t i = 0; i < adjSize; ++i) {
+        if (kind == GraphKind::Directed) {
+            if (colors[i] == 0) {
+                hasCycle = directedDfs(graph, i, colors, parent, cycleStart, cycleEnd, stack);
+            }
+        } else if (!visited[i]) {
+            dfs(graph, i, visited, parent, hasCycle, cycleStart, cycleEnd, stack);
+        }
+        if (hasCycle) {
+            // Walk the tree path back from cycleEnd to cycleStart, then close the loop
+            PathResult cycle;
+            cycle.found = true;
+            for (size_t current = cycleEnd; current != cycleStart; current = parent[current]) {
+                cycle.vertices.push_back(current);
             }
+            cycle.vertices.push_back(cycleStart);
+            reverse(cycle.vertices.begin(), cycle.vertices.end());
+            cycle.vertices.push_back(cycleStart);
+            return cycle;
         }
     }
 
-    return "-1";
+    PathResult none;
+    none.found = false;
+    return none;
+}
+
+template <typename Weight>
+vector<vector<size_t>> Algorithms::findStronglyConnectedComponents(const BasicGraph<Weight>& graph) {
+    vector<vector<size_t>> components;
+    forEachStrongComponent(graph, [&](const vector<size_t>& component) {
+        components.push_back(component);
+        return true;
+    });
+    return components;
+}
+
+template <typename Weight>
+string Algorithms::isContainsCycle(const BasicGraph<Weight>& graph, GraphKind kind) {
+    TraversalScratch scratch;
+    return isContainsCycle(graph, scratch, kind);
+}
+
+template <typename Weight>
+string Algorithms::isContainsCycle(const BasicGraph<Weight>& graph, TraversalScratch& scratch, GraphKind kind) {
+    PathResult cycle = findCycle(graph, scratch, kind);
+    return cycle.found ? joinVertices(cycle.vertices) : "-1";
+}
+
+template <typename Weight>
+PathResult Algorithms::findNegativeCycle(const BasicGraph<Weight>& graph) {
+    // Every vertex starts at distance 0, as if a virtual source reached all of them, so a negative
+    // cycle is found wherever it lies
+    vector<typename Relaxation<Weight>::Distance> distances(vertexCount(graph), 0);
+    vector<size_t> parent(distances.size(), UNDEFINED_SIZE_T);
+    size_t onCycle = spfa(graph, distances, parent);
+
+    PathResult cycle;
+    cycle.found = onCycle != UNDEFINED_SIZE_T;
+    if (cycle.found) {
+        // Parent pointers run against the edges: collect them backwards, then close and reverse
+        cycle.vertices.push_back(onCycle);
+        for (size_t current = parent[onCycle]; current != onCycle; current = parent[current]) {
+            cycle.vertices.push_back(current);
+        }
+        cycle.vertices.push_back(onCycle);
+        reverse(cycle.vertices.begin(), cycle.vertices.end());
+    }
+    return cycle;
 }
 
-string Algorithms::negativeCycle(const Graph& graph) {
-    const auto& adjMatrix = graph.getAdjacencyMatrix();
-    vector<int> distances(adjMatrix.size(), 0);
+template <typename Weight>
+bool Algorithms::hasNegativeCycle(const BasicGraph<Weight>& graph) {
+    return findNegativeCycle(graph).found;
+}
 
-    if (containsNegativeCycle(adjMatrix.size(), adjMatrix, distances)) {
+template <typename Weight>
+string Algorithms::negativeCycle(const BasicGraph<Weight>& graph) {
+    if (hasNegativeCycle(graph)) {
         return "The graph contains a negative cycle.";
     }
 
     return "The graph does not contain a negative cycle.";
-}
\ No newline at end of file
+}
+
+template <typename Weight>
+BasicGraph<Weight> Algorithms::allPairsShortestPaths(const BasicGraph<Weight>& graph) {
+    size_t adjSize = vertexCount(graph);
+    if (adjSize == 0) {
+        return BasicGraph<Weight>();
+    }
+
+    // Paths of at most one edge: zero to stay put, the edge weight, or no path at all
+    // in one flat row-major buffer that the graph adopts without a copy
+    vector<Weight> initial(adjSize * adjSize, infinity<Weight>());
+    for (size_t src = 0; src < adjSize; ++src) {
+        Weight* row = initial.data() + src * adjSize;
+        row[src] = 0;
+        forEachNeighbor(graph, src, [&](size_t dest, Weight weight) {
+            row[dest] = min(row[dest], weight);
+            return true;
+        });
+    }
+    BasicGraph<Weight> distances;
+    distances.loadGraph(std::move(initial), graph.getRows(), graph.getRows(), Representation::Dense);
+
+    // Each min-plus squaring doubles the path length covered. V-1 edges reach every shortest path,
+    // and covering V edges also closes every cycle, so a negative cycle shows up on the diagonal.
+    for (size_t covered = 1; covered < adjSize; covered *= 2) {
+        BasicGraph<Weight> squared = distances.minPlus(distances);
+        if (squared == distances) {
+            break; // Converged early
+        }
+        distances = squared;
+    }
+
+    const BasicMatrixView<Weight> result = distances.getAdjacencyMatrix();
+    for (size_t v = 0; v < adjSize; ++v) {
+        if (result[v][v] < 0) {
+            throw runtime_error("The graph contains a negative cycle.");
+        }
+    }
+    return distances;
+}
+
+template <typename Weight>
+PathResult BasicShortestPathTable<Weight>::route(size_t from, size_t to) const {
+    PathResult result;
+    result.found = false;
+    if (distance(from, to) == infinity<Weight>()) {
+        return result;
+    }
+    // A reachable negative cycle on the way leaves the pair without a shortest path
+    for (size_t k = 0; negativeCycle && k < vertices; ++k) {
+        if (distance(k, k) < 0 && distance(from, k) != infinity<Weight>() && distance(k, to) != infinity<Weight>()) {
+            return result;
+        }
+    }
+
+    result.found = true;
+    result.vertices.push_back(from);
+    for (size_t current = from; current != to;) {
+        current = nextHop[current * vertices + to];
+        result.vertices.push_back(current);
+    }
+    return result;
+}
+
+template <typename Weight>
+string BasicShortestPathTable<Weight>::path(size_t from, size_t to) const {
+    PathResult result = route(from, to);
+    return result.found ? joinVertices(result.vertices) : "-1";
+}
+
+template <typename Weight>
+BasicShortestPathTable<Weight> Algorithms::floydWarshall(const BasicGraph<Weight>& graph) {
+    size_t n = vertexCount(graph);
+    BasicShortestPathTable<Weight> table;
+    table.vertices = n;
+    table.distances.assign(n * n, infinity<Weight>());
+    table.nextHop.assign(n * n, UNDEFINED_SIZE_T);
+    vector<Weight>& distances = table.distances;
+    vector<size_t>& nextHop = table.nextHop;
+
+    for (size_t src = 0; src < n; ++src) {
+        distances[src * n + src] = 0;
+        nextHop[src * n + src] = src;
+        forEachNeighbor(graph, src, [&](size_t dest, Weight weight) {
+            if (weight < distances[src * n + dest]) {
+                distances[src * n + dest] = weight;
+                nextHop[src * n + dest] = dest;
+            }
+            return true;
+        });
+    }
+
+    // Three phases per diagonal block kb: the block itself, then its row and column of blocks,
+    // then every remaining block, which depends only on the first two phases
+    const size_t block = FLOYD_WARSHALL_BLOCK;
+    for (size_t kb = 0; kb < n; kb += block) {
+        size_t kEnd = min(kb + block, n);
+        relaxTile(distances, nextHop, n, kb, kEnd, kb, kEnd, kb, kEnd);
+
+        for (size_t b = 0; b < n; b += block) {
+            if (b != kb) {
+                size_t bEnd = min(b + block, n);
+                relaxTile(distances, nextHop, n, kb, kEnd, b, bEnd, kb, kEnd);
+                relaxTile(distances, nextHop, n, b, bEnd, kb, kEnd, kb, kEnd);
+            }
+        }
+
+        auto remaining = [&](size_t rowBlockBegin, size_t rowBlockEnd) {
+            for (size_t ib = rowBlockBegin * block; ib < rowBlockEnd * block; ib += block) {
+                if (ib == kb) {
+                    continue;
+                }
+                size_t iEnd = min(ib + block, n);
+                for (size_t jb = 0; jb < n; jb += block) {
+                    if (jb != kb) {
+                        relaxTile(distances, nextHop, n, ib, iEnd, jb, min(jb + block, n), kb, kEnd);
+                    }
+                }
+            }
+        };
+        size_t blockCount = (n + block - 1) / block;
+        if (n < PARALLEL_FLOYD_WARSHALL_MIN_VERTICES) {
+            remaining(0, blockCount);
+        } else {
+            ThreadPool::shared().parallelFor(0, blockCount, remaining);
+        }
+    }
+
+    for (size_t v = 0; v < n; ++v) {
+        if (distances[v * n + v] < 0) {
+            table.negativeCycle = true;
+        }
+    }
+    return table;
+}
+#define ARIEL_INSTANTIATE_ALGORITHMS(Weight) \
+    template class ariel::BasicShortestPathTable<Weight>; \
+    template PathResult Algorithms::findShortestPath(const BasicGraph<Weight>&, size_t, size_t, ShortestPathMode); \
+    template PathResult Algorithms::findShortestPathAStar(const BasicGraph<Weight>&, size_t, size_t, const BasicDistanceHeuristic<Weight>::type&); \
+    template vector<PathResult> Algorithms::findShortestPaths(const BasicGraph<Weight>&, const vector<pair<size_t, size_t>>&, ShortestPathMode); \
+    template BipartiteResult Algorithms::findBipartition(const BasicGraph<Weight>&); \
+    template PathResult Algorithms::findCycle(const BasicGraph<Weight>&, GraphKind); \
+    template PathResult Algorithms::findCycle(const BasicGraph<Weight>&, TraversalScratch&, GraphKind); \
+    template vector<vector<size_t>> Algorithms::findStronglyConnectedComponents(const BasicGraph<Weight>&); \
+    template PathResult Algorithms::findNegativeCycle(const BasicGraph<Weight>&); \
+    template bool Algorithms::hasNegativeCycle(const BasicGraph<Weight>&); \
+    template bool Algorithms::isConnected(const BasicGraph<Weight>&, GraphKind); \
+    template bool Algorithms::isConnected(const BasicGraph<Weight>&, TraversalScratch&, GraphKind); \
+    template string Algorithms::shortestPath(const BasicGraph<Weight>&, size_t, size_t, ShortestPathMode); \
+    template string Algorithms::shortestPathAStar(const BasicGraph<Weight>&, size_t, size_t, const BasicDistanceHeuristic<Weight>::type&); \
+    template vector<string> Algorithms::shortestPaths(const BasicGraph<Weight>&, const vector<pair<size_t, size_t>>&, ShortestPathMode); \
+    template string Algorithms::isBipartite(const BasicGraph<Weight>&); \
+    template string Algorithms::isContainsCycle(const BasicGraph<Weight>&, GraphKind); \
+    template string Algorithms::isContainsCycle(const BasicGraph<Weight>&, TraversalScratch&, GraphKind); \
+    template string Algorithms::negativeCycle(const BasicGraph<Weight>&); \
+    template BasicGraph<Weight> Algorithms::allPairsShortestPaths(const BasicGraph<Weight>&); \
+    template BasicShortestPathTable<Weight> Algorithms::floydWarshall(const BasicGraph<Weight>&);
+
+ARIEL_FOR_EACH_WEIGHT(ARIEL_INSTANTIATE_ALGORITHMS)
@@ -6,19 +6,155 @@
 #include "Graph.hpp"
 #include <string>
 #include <vector>
+#include <utility>
+#include <functional>
 
 namespace ariel {
+    // Single-source engine used by Algorithms::shortestPath
+    enum class ShortestPathMode {
+        Auto,        // Dijkstra when no edge weight is negative, SPFA otherwise
+        Dijkstra,    // Binary-heap Dijkstra; the caller guarantees non-negative weights
+        BellmanFord, // Round-based, stops after the first round without a relaxation
+        Spfa,        // Queue-based Bellman-Ford, rescans only vertices whose distance improved
+        BidirectionalDijkstra // Dijkstra from both endpoints until the searches meet; non-negative weights only
+    };
+
+    // Lower bound on the distance from a vertex to the target of an A* query. It must never
+    // overestimate; a heuristic returning 0 everywhere makes A* plain Dijkstra.
+    template <typename Weight>
+    struct BasicDistanceHeuristic {
+        typedef std::function<Weight(size_t)> type;
+    };
+    typedef BasicDistanceHeuristic<int>::type DistanceHeuristic;
+
+    // How the graph algorithms read the adjacency matrix
+    enum class GraphKind {
+        Undirected, // Symmetric matrix: every edge is stored in both directions
+        Directed    // Cell (i, j) is an edge from i to j only
+    };
+
+    // A vertex sequence, e.g. a path or a closed cycle (first vertex repeated at the end)
+    struct PathResult {
+        bool found;
+        std::vector<size_t> vertices;
+    };
+
+    // A 2-coloring of the vertices; the sides are empty when the graph is not bipartite
+    struct BipartiteResult {
+        bool bipartite;
+        std::vector<size_t> sideA;
+        std::vector<size_t> sideB;
+    };
+
+    // All-pairs shortest distances plus next-hop links, built once by Algorithms::floydWarshall
+    template <typename Weight>
+    class BasicShortestPathTable {
+    public:
+        BasicShortestPathTable() : vertices(0), negativeCycle(false) {}
+
+        size_t size() const { return vertices; }
+
+        // BasicGraph<Weight>::INFINITE_DISTANCE when to is unreachable from from
+        Weight distance(size_t from, size_t to) const { return distances[from * vertices + to]; }
+
+        // Vertices of the shortest path; not found when unreachable or through a negative cycle
+        PathResult route(size_t from, size_t to) const;
+
+        // route() in the shortestPath format ("0->2->1"), or "-1" when there is no shortest path
+        std::string path(size_t from, size_t to) const;
+
+        bool hasNegativeCycle() const { return negativeCycle; }
+
+    private:
+        friend class Algorithms;
+
+        size_t vertices;
+        std::vector<Weight> distances; // Row-major vertices x vertices
+        std::vector<size_t> nextHop; // First vertex after from on the path from -> to
+        bool negativeCycle;
+    };
+
+    typedef BasicShortestPathTable<int> ShortestPathTable;
+
+    // Explicit DFS stack of (vertex, next edge cursor) frames
+    typedef std::vector<std::pair<size_t, size_t>> DfsStack;
+
+    // Buffers of the DFS-based searches. Pass one to isConnected, findCycle or isContainsCycle
+    // repeatedly and the buffers grow once and are reused by every later call.
+    struct TraversalScratch {
+        DfsStack stack;
+        std::vector<bool> visited;
+        std::vector<int> colors;
+        std::vector<size_t> parent;
+    };
+
+    // Every algorithm is a template over the graph's weight type, compiled for the types in
+    // ARIEL_FOR_EACH_WEIGHT
     class Algorithms {
     public:
-        static bool isConnected(const Graph& graph);
-        static std::string shortestPath(const Graph& graph, size_t start, size_t end);
-        static std::string isBipartite(const Graph& graph);
-        static std::string isContainsCycle(const Graph& graph);
-        static std::string negativeCycle(const Graph& graph);
+        // The string functions below format the results of these
+        template <typename Weight>
+        static PathResult findShortestPath(const BasicGraph<Weight>& graph, size_t start, size_t end, ShortestPathMode mode = ShortestPathMode::Auto);
+        template <typename Weight>
+        static PathResult findShortestPathAStar(const BasicGraph<Weight>& graph, size_t start, size_t end, const typename BasicDistanceHeuristic<Weight>::type& heuristic);
+        template <typename Weight>
+        static std::vector<PathResult> findShortestPaths(const BasicGraph<Weight>& graph, const std::vector<std::pair<size_t, size_t>>& queries, ShortestPathMode mode = ShortestPathMode::Auto);
+        template <typename Weight>
+        static BipartiteResult findBipartition(const BasicGraph<Weight>& graph);
+        template <typename Weight>
+        static PathResult findCycle(const BasicGraph<Weight>& graph, GraphKind kind = GraphKind::Undirected);
+        template <typename Weight>
+        static PathResult findCycle(const BasicGraph<Weight>& graph, TraversalScratch& scratch, GraphKind kind = GraphKind::Undirected);
+
+        // Strongly connected components in reverse topological order, each sorted by vertex
+        template <typename Weight>
+        static std::vector<std::vector<size_t>> findStronglyConnectedComponents(const BasicGraph<Weight>& graph);
+        template <typename Weight>
+        static PathResult findNegativeCycle(const BasicGraph<Weight>& graph);
+        template <typename Weight>
+        static bool hasNegativeCycle(const BasicGraph<Weight>& graph);
+
+        // Directed asks for strong connectivity: every vertex reaches every other vertex
+        template <typename Weight>
+        static bool isConnected(const BasicGraph<Weight>& graph, GraphKind kind = GraphKind::Undirected);
+        template <typename Weight>
+        static bool isConnected(const BasicGraph<Weight>& graph, TraversalScratch& scratch, GraphKind kind = GraphKind::Undirected);
+        template <typename Weight>
+        static std::string shortestPath(const BasicGraph<Weight>& graph, size_t start, size_t end, ShortestPathMode mode = ShortestPathMode::Auto);
+
+        // A* search guided by heuristic; non-negative weights only
+        template <typename Weight>
+        static std::string shortestPathAStar(const BasicGraph<Weight>& graph, size_t start, size_t end, const typename BasicDistanceHeuristic<Weight>::type& heuristic);
+
+        // Batch of (start, end) queries, answered in order; one solve per distinct start, run in parallel
+        template <typename Weight>
+        static std::vector<std::string> shortestPaths(const BasicGraph<Weight>& graph, const std::vector<std::pair<size_t, size_t>>& queries, ShortestPathMode mode = ShortestPathMode::Auto);
+        template <typename Weight>
+        static std::string isBipartite(const BasicGraph<Weight>& graph);
+        template <typename Weight>
+        static std::string isContainsCycle(const BasicGraph<Weight>& graph, GraphKind kind = GraphKind::Undirected);
+        template <typename Weight>
+        static std::string isContainsCycle(const BasicGraph<Weight>& graph, TraversalScratch& scratch, GraphKind kind = GraphKind::Undirected);
+        template <typename Weight>
+        static std::string negativeCycle(const BasicGraph<Weight>& graph);
+
+        // Distance matrix of all shortest paths; BasicGraph<Weight>::INFINITE_DISTANCE marks unreachable pairs
+        template <typename Weight>
+        static BasicGraph<Weight> allPairsShortestPaths(const BasicGraph<Weight>& graph);
+
+        // Cache-blocked Floyd-Warshall; the table answers distance and path queries without re-running
+        template <typename Weight>
+        static BasicShortestPathTable<Weight> floydWarshall(const BasicGraph<Weight>& graph);
 
     private:
-        static void dfs1(const Graph& graph, size_t vertex, std::vector<bool>& visited);
-        static void dfs(const Graph& graph, size_t vertex, std::vector<bool>& visited, std::vector<size_t>& parent, bool& hasCycle, size_t& cycleStart, size_t& cycleEnd);
+        template <typename Weight>
+        static void dfs1(const BasicGraph<Weight>& graph, size_t root, std::vector<bool>& visited, DfsStack& stack);
+        template <typename Weight>
+        static void dfs(const BasicGraph<Weight>& graph, size_t root, std::vector<bool>& visited, std::vector<size_t>& parent, bool& hasCycle, size_t& cycleStart, size_t& cycleEnd, DfsStack& stack);
+
+        // Three-color DFS for directed graphs; colors are 0 (unvisited), 1 (on the stack) and 2 (done)
+        template <typename Weight>
+        static bool directedDfs(const BasicGraph<Weight>& graph, size_t root, std::vector<int>& colors, std::vector<size_t>& parent, size_t& cycleStart, size_t& cycleEnd, DfsStack& stack);
     };
 }
 
@@ -1,11 +1,123 @@
 #include "Graph.hpp"
+#include "Kernels.hpp"
+#include "ThreadPool.hpp"
 #include <stdexcept>
 #include <sstream>
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <utility>
 
 namespace ariel {
 
+    namespace {
+        // Edge density (non-zero cells / all cells) at or below which Representation::Auto picks Sparse
+        const double SPARSE_DENSITY_THRESHOLD = 0.1;
+
+        // Smallest matrix product worth splitting across threads
+        const size_t PARALLEL_MULTIPLY_MIN_ROWS = 128;
+
+        // Insert, update or erase edge (row, col) of a CSR index; zero erases
+        template <typename Weight>
+        void patchSparseCell(BasicSparseAdjacency<Weight>& adjacency, size_t row, size_t col, Weight val) {
+            std::vector<size_t>& offsets = adjacency.offsets;
+            std::vector<size_t>& neighbors = adjacency.neighbors;
+            std::vector<Weight>& weights = adjacency.weights;
+
+            // Neighbors within a row are sorted, so the edge is found by binary search
+            auto first = neighbors.begin() + static_cast<std::ptrdiff_t>(offsets[row]);
+            auto last = neighbors.begin() + static_cast<std::ptrdiff_t>(offsets[row + 1]);
+            auto found = std::lower_bound(first, last, col);
+            std::ptrdiff_t position = found - neighbors.begin();
+
+            if (found != last && *found == col) {
+                if (val != 0) {
+                    weights[static_cast<size_t>(position)] = val;
+                    return;
+                }
+                neighbors.erase(found);
+                weights.erase(weights.begin() + position);
+                for (size_t i = row + 1; i < offsets.size(); ++i) {
+                    --offsets[i];
+                }
+            } else if (val != 0) {
+                neighbors.insert(found, col);
+                weights.insert(weights.begin() + position, val);
+                for (size_t i = row + 1; i < offsets.size(); ++i) {
+                    ++offsets[i];
+                }
+            }
+        }
+    }
+
+// Disjoint sets constructor
+/**
+ * @brief Construct size singleton sets, one per element.
+ *
+ * @param size Number of elements.
+ */
+    DisjointSets::DisjointSets(std::size_t size) : parent(size), rank(size, 0), sets(size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            parent[i] = i;
+        }
+    }
+
+// Find a set representative
+/**
+ * @brief Find the root of the tree holding element, halving the path on the way up.
+ *
+ * @param element The element to look up.
+ * @return std::size_t The representative of the set.
+ */
+    std::size_t DisjointSets::find(std::size_t element) {
+        while (parent[element] != element) {
+            parent[element] = parent[parent[element]];
+            element = parent[element];
+        }
+        return element;
+    }
+
+// Merge two sets
+/**
+ * @brief Merge the sets holding a and b, hanging the shorter tree under the taller one.
+ *
+ * @param a An element of the first set.
+ * @param b An element of the second set.
+ * @return true If two different sets were merged.
+ * @return false If a and b were already in the same set.
+ */
+    bool DisjointSets::unite(std::size_t a, std::size_t b) {
+        std::size_t rootA = find(a);
+        std::size_t rootB = find(b);
+        if (rootA == rootB) {
+            return false;
+        }
+        if (rank[rootA] < rank[rootB]) {
+            std::swap(rootA, rootB);
+        }
+        parent[rootB] = rootA;
+        if (rank[rootA] == rank[rootB]) {
+            ++rank[rootA];
+        }
+        --sets;
+        return true;
+    }
+
+// Bit matrix constructor
+/**
+ * @brief Construct an all-zero bit matrix; every row is padded to whole 64-bit words.
+ *
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ */
+    const std::size_t BitMatrix::WORD_BITS;
+
+    template <typename Weight>
+    constexpr Weight BasicGraph<Weight>::INFINITE_DISTANCE;
+
+    BitMatrix::BitMatrix(std::size_t rows, std::size_t cols)
+            : rows(rows), cols(cols), wordsPerRow((cols + WORD_BITS - 1) / WORD_BITS), words(rows * wordsPerRow, 0) {}
+
 // Constructor with dimensions
 /**
  * @brief Construct a new Graph object with specified dimensions.
@@ -13,28 +125,99 @@ namespace ariel {
  * @param rows Number of rows in the graph's adjacency matrix.
  * @param cols Number of columns in the graph's adjacency matrix.
  */
-    Graph::Graph(int rows, int cols)
-            : rows(rows), cols(cols), matrix(static_cast<std::vector<int>::size_type>(rows), std::vector<int>(static_cast<std::vector<int>::size_type>(cols), 0)) {}
+    template <typename Weight>
+    BasicGraph<Weight>::BasicGraph(int rows, int cols)
+            : rows(rows), cols(cols), matrix(static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols), 0),
+              borrowed(nullptr), sparse(false), bitMatrix(static_cast<std::size_t>(rows), static_cast<std::size_t>(cols)),
+              connectivityTracked(false), asymmetricPairs(0), edgeCount(0), negativeCount(0) {}
 
 // Default constructor
 /**
  * @brief Construct a new Graph object with default dimensions (0, 0).
  */
-    Graph::Graph() : Graph(0, 0) {}
+    template <typename Weight>
+    BasicGraph<Weight>::BasicGraph() : BasicGraph(0, 0) {}
 
 // Destructor
 /**
  * @brief Destroy the Graph object.
  */
-    Graph::~Graph() {}
+    template <typename Weight>
+    BasicGraph<Weight>::~BasicGraph() {}
+
+// Move constructor
+/**
+ * @brief Take over another graph's buffers without copying them.
+ *
+ * @param other The graph to move from; it is left empty (0 x 0).
+ */
+    template <typename Weight>
+    BasicGraph<Weight>::BasicGraph(BasicGraph<Weight>&& other) noexcept
+            : rows(other.rows), cols(other.cols), matrix(std::move(other.matrix)), borrowed(other.borrowed), sparse(other.sparse),
+              sparseAdjacency(std::move(other.sparseAdjacency)), reverseSparseAdjacency(std::move(other.reverseSparseAdjacency)),
+              bitMatrix(std::move(other.bitMatrix)), connectivityTracked(other.connectivityTracked), components(std::move(other.components)),
+              asymmetricPairs(other.asymmetricPairs), edgeCount(other.edgeCount), negativeCount(other.negativeCount) {
+        other.rows = 0;
+        other.cols = 0;
+        other.borrowed = nullptr;
+        other.sparse = false;
+        other.bitMatrix = BitMatrix(0, 0);
+        other.connectivityTracked = false;
+        other.components = DisjointSets();
+        other.asymmetricPairs = 0;
+        other.edgeCount = 0;
+        other.negativeCount = 0;
+    }
+
+// Move assignment
+/**
+ * @brief Replace this graph with another graph's buffers without copying them.
+ *
+ * @param other The graph to move from; it is left empty (0 x 0).
+ * @return Graph& Reference to this graph.
+ */
+    template <typename Weight>
+    BasicGraph<Weight>& BasicGraph<Weight>::operator=(BasicGraph<Weight>&& other) noexcept {
+        if (this != &other) {
+            rows = other.rows;
+            cols = other.cols;
+            matrix = std::move(other.matrix);
+            borrowed = other.borrowed;
+            sparse = other.sparse;
+            sparseAdjacency = std::move(other.sparseAdjacency);
+            reverseSparseAdjacency = std::move(other.reverseSparseAdjacency);
+            bitMatrix = std::move(other.bitMatrix);
+            connectivityTracked = other.connectivityTracked;
+            components = std::move(other.components);
+            asymmetricPairs = other.asymmetricPairs;
+            edgeCount = other.edgeCount;
+            negativeCount = other.negativeCount;
+            other.rows = 0;
+            other.cols = 0;
+            other.matrix.clear();
+            other.borrowed = nullptr;
+            other.sparse = false;
+            other.sparseAdjacency = BasicSparseAdjacency<Weight>();
+            other.reverseSparseAdjacency = BasicSparseAdjacency<Weight>();
+            other.bitMatrix = BitMatrix(0, 0);
+            other.connectivityTracked = false;
+            other.components = DisjointSets();
+            other.asymmetricPairs = 0;
+            other.edgeCount = 0;
+            other.negativeCount = 0;
+        }
+        return *this;
+    }
 
 // Load graph from an adjacency matrix
 /**
  * @brief Load the graph from an adjacency matrix.
  *
  * @param adjacencyMatrix A 2D vector representing the adjacency matrix of the graph.
+ * @param representation How the algorithms should traverse the graph; Auto decides by edge density.
  */
-    void Graph::loadGraph(const std::vector<std::vector<int>>& adjacencyMatrix) {
+    template <typename Weight>
+    void BasicGraph<Weight>::loadGraph(const std::vector<std::vector<Weight>>& adjacencyMatrix, Representation representation) {
         if (adjacencyMatrix.empty()) {
             std::cerr << "Error: Empty adjacency matrix." << std::endl;
             return;
@@ -51,19 +234,307 @@ namespace ariel {
             }
         }
 
-        // If dimensions have changed, resize the matrix
-        if (newRows != static_cast<size_t>(rows) || newCols != static_cast<size_t>(cols)) {
-            rows = static_cast<int>(newRows);
-            cols = static_cast<int>(newCols);
-            matrix.resize(static_cast<std::vector<int>::size_type>(rows), std::vector<int>(static_cast<std::vector<int>::size_type>(cols), 0));
+        // Resize the contiguous buffer; this reallocates only when the cell count grows
+        rows = static_cast<int>(newRows);
+        cols = static_cast<int>(newCols);
+        matrix.resize(newRows * newCols);
+
+        borrowed = nullptr;
+
+        // Copy each input row into its slice of the buffer
+        for (size_t i = 0; i < newRows; ++i) {
+            std::copy(adjacencyMatrix[i].begin(), adjacencyMatrix[i].end(), matrix.begin() + static_cast<std::ptrdiff_t>(index(i, 0)));
         }
 
-        // Copy the contents of the adjacencyMatrix to the matrix
+        countCells();
+        setRepresentation(representation);
+        refreshComponents();
+    }
+
+// Load graph from a temporary adjacency matrix
+/**
+ * @brief Load the graph from an adjacency matrix the caller gives up.
+ *
+ * The rows are separate allocations, so they cannot become the contiguous buffer; each one is
+ * released as soon as it is copied and the input is left empty. Use the flat overload to avoid the copy.
+ *
+ * @param adjacencyMatrix A 2D vector representing the adjacency matrix of the graph.
+ * @param representation How the algorithms should traverse the graph; Auto decides by edge density.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::loadGraph(std::vector<std::vector<Weight>>&& adjacencyMatrix, Representation representation) {
+        if (adjacencyMatrix.empty()) {
+            std::cerr << "Error: Empty adjacency matrix." << std::endl;
+            return;
+        }
+
+        size_t newRows = adjacencyMatrix.size();
+        size_t newCols = adjacencyMatrix[0].size();
+        for (const auto& row : adjacencyMatrix) {
+            if (row.size() != newCols) {
+                std::cerr << "Error: Dimension mismatch while loading the graph." << std::endl;
+                return;
+            }
+        }
+
+        rows = static_cast<int>(newRows);
+        cols = static_cast<int>(newCols);
+        matrix.resize(newRows * newCols);
+        borrowed = nullptr;
+
         for (size_t i = 0; i < newRows; ++i) {
-            for (size_t j = 0; j < newCols; ++j) {
-                matrix[i][j] = adjacencyMatrix[i][j];
+            std::copy(adjacencyMatrix[i].begin(), adjacencyMatrix[i].end(), matrix.begin() + static_cast<std::ptrdiff_t>(index(i, 0)));
+            std::vector<Weight>().swap(adjacencyMatrix[i]);
+        }
+        adjacencyMatrix.clear();
+
+        countCells();
+        setRepresentation(representation);
+        refreshComponents();
+    }
+
+// Load graph from a flat buffer
+/**
+ * @brief Load the graph by taking over a flat row-major buffer; no cell is copied.
+ *
+ * @param cells rows * cols cells, row by row; left empty.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param representation How the algorithms should traverse the graph; Auto decides by edge density.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::loadGraph(std::vector<Weight>&& cells, int rows, int cols, Representation representation) {
+        if (rows <= 0 || cols <= 0) {
+            std::cerr << "Error: Empty adjacency matrix." << std::endl;
+            return;
+        }
+        if (cells.size() != static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols)) {
+            std::cerr << "Error: Dimension mismatch while loading the graph." << std::endl;
+            return;
+        }
+
+        this->rows = rows;
+        this->cols = cols;
+        matrix = std::move(cells);
+        borrowed = nullptr;
+
+        countCells();
+        setRepresentation(representation);
+        refreshComponents();
+    }
+
+// Load graph as a view of caller-owned cells
+/**
+ * @brief Load the graph from a caller-owned row-major buffer.
+ *
+ * When the rows are packed (stride == cols) the graph reads the buffer in place: it must stay
+ * alive and unchanged until the graph is reloaded or destroyed, and the first write copies it
+ * into the graph's own storage. Padded rows are packed into owned storage instead, since the
+ * element-wise and product kernels work on contiguous rows.
+ *
+ * @param cells The first cell of row 0.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param stride Distance in cells between the starts of consecutive rows; at least cols.
+ * @param representation How the algorithms should traverse the graph; Auto decides by edge density.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::loadGraph(const Weight* cells, int rows, int cols, int stride, Representation representation) {
+        if (cells == nullptr || rows <= 0 || cols <= 0) {
+            std::cerr << "Error: Empty adjacency matrix." << std::endl;
+            return;
+        }
+        if (stride < cols) {
+            std::cerr << "Error: Dimension mismatch while loading the graph." << std::endl;
+            return;
+        }
+
+        this->rows = rows;
+        this->cols = cols;
+        if (stride == cols) {
+            matrix = std::vector<Weight>(); // Release any previous buffer
+            borrowed = cells;
+        } else {
+            size_t numCols = static_cast<size_t>(cols);
+            size_t rowStride = static_cast<size_t>(stride);
+            matrix.resize(cellCount());
+            borrowed = nullptr;
+            for (size_t i = 0; i < static_cast<size_t>(rows); ++i) {
+                std::copy(cells + i * rowStride, cells + i * rowStride + numCols, matrix.begin() + static_cast<std::ptrdiff_t>(index(i, 0)));
             }
         }
+
+        countCells();
+        setRepresentation(representation);
+        refreshComponents();
+    }
+
+// Take ownership of borrowed cells
+/**
+ * @brief Copy the borrowed cells into the graph's own buffer so they can be written. Does nothing
+ * when the graph already owns its cells.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::ownCells() {
+        if (borrowed != nullptr) {
+            matrix.assign(borrowed, borrowed + cellCount());
+            borrowed = nullptr;
+        }
+    }
+
+// Choose the traversal representation
+/**
+ * @brief Switch between dense and sparse (CSR) traversal.
+ *
+ * The adjacency matrix is kept either way; Sparse additionally maintains a CSR index so the
+ * algorithms visit only existing edges. Auto picks Sparse when the edge density is at most
+ * SPARSE_DENSITY_THRESHOLD.
+ *
+ * @param representation The requested representation.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::setRepresentation(Representation representation) {
+        if (representation == Representation::Auto) {
+            size_t total = cellCount();
+            sparse = total != 0 && static_cast<double>(edgeCount) <= SPARSE_DENSITY_THRESHOLD * static_cast<double>(total);
+        } else {
+            sparse = representation == Representation::Sparse;
+        }
+
+        if (sparse) {
+            refreshSparseAdjacency();
+        } else {
+            sparseAdjacency = BasicSparseAdjacency<Weight>(); // Release the index memory
+            reverseSparseAdjacency = BasicSparseAdjacency<Weight>();
+        }
+        refreshBitMatrix();
+    }
+
+// Rebuild the CSR indexes
+/**
+ * @brief Rebuild the forward and reverse CSR indexes from the adjacency matrix. Does nothing for dense graphs.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::refreshSparseAdjacency() {
+        if (!sparse) {
+            return;
+        }
+
+        size_t numRows = static_cast<size_t>(rows);
+        size_t numCols = static_cast<size_t>(cols);
+        sparseAdjacency.offsets.assign(numRows + 1, 0);
+        sparseAdjacency.neighbors.clear();
+        sparseAdjacency.weights.clear();
+        negativeCount = 0;
+
+        for (size_t i = 0; i < numRows; ++i) {
+            for (size_t j = 0; j < numCols; ++j) {
+                Weight weight = cells()[index(i, j)];
+                if (weight != 0) {
+                    sparseAdjacency.neighbors.push_back(j);
+                    sparseAdjacency.weights.push_back(weight);
+                    negativeCount += weight < 0 ? 1u : 0u;
+                }
+            }
+            sparseAdjacency.offsets[i + 1] = sparseAdjacency.neighbors.size();
+        }
+        edgeCount = sparseAdjacency.neighbors.size();
+
+        // Transpose by counting sort; scanning sources in order keeps every reverse row sorted
+        std::vector<size_t>& reverseOffsets = reverseSparseAdjacency.offsets;
+        reverseOffsets.assign(numCols + 1, 0);
+        for (size_t j : sparseAdjacency.neighbors) {
+            ++reverseOffsets[j + 1];
+        }
+        for (size_t j = 0; j < numCols; ++j) {
+            reverseOffsets[j + 1] += reverseOffsets[j];
+        }
+
+        size_t edgeCount = sparseAdjacency.neighbors.size();
+        reverseSparseAdjacency.neighbors.assign(edgeCount, 0);
+        reverseSparseAdjacency.weights.assign(edgeCount, 0);
+        std::vector<size_t> cursor(reverseOffsets.begin(), reverseOffsets.end() - 1);
+        for (size_t i = 0; i < numRows; ++i) {
+            for (size_t e = sparseAdjacency.offsets[i]; e < sparseAdjacency.offsets[i + 1]; ++e) {
+                size_t slot = cursor[sparseAdjacency.neighbors[e]]++;
+                reverseSparseAdjacency.neighbors[slot] = i;
+                reverseSparseAdjacency.weights[slot] = sparseAdjacency.weights[e];
+            }
+        }
+    }
+
+// Patch one cell of the CSR indexes
+/**
+ * @brief Insert, update or erase a single edge of the forward and reverse CSR indexes. Does nothing for dense graphs.
+ *
+ * @param row The source vertex.
+ * @param col The destination vertex.
+ * @param val The new weight; zero removes the edge.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::updateSparseCell(size_t row, size_t col, Weight val) {
+        if (!sparse) {
+            return;
+        }
+
+        patchSparseCell(sparseAdjacency, row, col, val);
+        patchSparseCell(reverseSparseAdjacency, col, row, val);
+    }
+
+// Track connectivity
+/**
+ * @brief Turn the disjoint-set connectivity index on or off.
+ *
+ * While it is on, setAdjacencyMatrix folds each new edge into the components in near-constant
+ * time, so Algorithms::isConnected answers without a traversal. Edges count in both directions.
+ *
+ * @param enabled Whether to maintain the index.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::setConnectivityTracking(bool enabled) {
+        connectivityTracked = enabled;
+        if (enabled) {
+            refreshComponents();
+        } else {
+            components = DisjointSets(); // Release the index memory
+        }
+    }
+
+// Rebuild the connected components
+/**
+ * @brief Rebuild the disjoint-set forest and the count of one-way vertex pairs from the adjacency
+ * matrix. Does nothing unless connectivity is tracked.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::refreshComponents() {
+        if (!connectivityTracked) {
+            return;
+        }
+
+        components = DisjointSets(static_cast<size_t>(rows));
+        asymmetricPairs = 0;
+        for (size_t i = 0; i < static_cast<size_t>(rows); ++i) {
+            for (size_t j = 0; j < static_cast<size_t>(cols); ++j) {
+                bool edge = cells()[index(i, j)] != 0;
+                if (edge) {
+                    components.unite(i, j);
+                }
+                if (i < j && j < static_cast<size_t>(rows) && edge != (cells()[index(j, i)] != 0)) {
+                    ++asymmetricPairs;
+                }
+            }
+        }
+    }
+
+// Rebuild the derived indexes
+/**
+ * @brief Rebuild the CSR indexes and the connected components after a bulk change to the matrix.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::refreshIndexes() {
+        refreshSparseAdjacency();
+        refreshBitMatrix();
+        refreshComponents();
     }
 
 // Print the graph
@@ -72,19 +543,22 @@ namespace ariel {
  *
  * @return std::string The string representation of the graph's adjacency matrix.
  */
-    std::string Graph::printGraph() const {
+    template <typename Weight>
+    std::string BasicGraph<Weight>::printGraph() const {
         std::ostringstream oss;  // Declare the output string stream
+        const BasicMatrixView<Weight> view = getAdjacencyMatrix();
 
-        for (const auto& row : matrix) {
+        for (std::size_t r = 0; r < view.size(); ++r) {
+            const BasicRowView<Weight> row = view[r];
             oss << "[";
             for (std::size_t i = 0; i < row.size(); ++i) {
-                oss << row[i];
+                oss << +row[i]; // Unary plus prints byte weights as numbers, not characters
                 if (i < row.size() - 1) {
                     oss << ", ";
                 }
             }
             oss << "]";
-            if (&row != &matrix.back()) {
+            if (r + 1 < view.size()) {
                 oss << "\n";
             }
         }
@@ -94,12 +568,60 @@ namespace ariel {
 
 // Get adjacency matrix
 /**
- * @brief Get the adjacency matrix of the graph.
+ * @brief Get a row-indexable view of the adjacency matrix of the graph.
+ *
+ * The view borrows the graph's contiguous buffer and stays valid until the graph is modified or destroyed.
  *
- * @return const std::vector<std::vector<int>>& Reference to the adjacency matrix.
+ * @return MatrixView View supporting view.size() and view[row][col].
+ */
+    template <typename Weight>
+    BasicMatrixView<Weight> BasicGraph<Weight>::getAdjacencyMatrix() const {
+        return BasicMatrixView<Weight>(cells(), static_cast<std::size_t>(rows), static_cast<std::size_t>(cols));
+    }
+
+// Rebuild the bit matrix
+/**
+ * @brief Pack every non-zero cell of the adjacency matrix into the bit matrix of a dense graph,
+ * or release the bit matrix of a sparse one.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::refreshBitMatrix() {
+        if (sparse) {
+            bitMatrix = BitMatrix(0, 0); // Release the index memory
+            return;
+        }
+
+        size_t numRows = static_cast<size_t>(rows);
+        size_t numCols = static_cast<size_t>(cols);
+        bitMatrix = BitMatrix(numRows, numCols);
+        edgeCount = 0;
+        negativeCount = 0;
+        for (size_t i = 0; i < numRows; ++i) {
+            for (size_t j = 0; j < numCols; ++j) {
+                Weight weight = cells()[index(i, j)];
+                if (weight != 0) {
+                    bitMatrix.set(i, j);
+                    ++edgeCount;
+                    negativeCount += weight < 0 ? 1u : 0u;
+                }
+            }
+        }
+    }
+
+// Count the edges
+/**
+ * @brief Recount the non-zero and the negative cells, for a load to pick its representation from.
+ * Bulk operators get the counts from the index rebuild instead, which scans the cells anyway.
  */
-    const std::vector<std::vector<int>>& Graph::getAdjacencyMatrix() const {
-        return matrix;
+    template <typename Weight>
+    void BasicGraph<Weight>::countCells() {
+        edgeCount = 0;
+        negativeCount = 0;
+        const Weight* first = cells();
+        for (size_t i = 0; i < cellCount(); ++i) {
+            edgeCount += first[i] != 0 ? 1u : 0u;
+            negativeCount += first[i] < 0 ? 1u : 0u;
+        }
     }
 
 // Set a specific value in the adjacency matrix
@@ -111,11 +633,46 @@ namespace ariel {
  * @param val The value to set.
  * @throws std::out_of_range If the index is out of range.
  */
-    void Graph::setAdjacencyMatrix(int row, int col, int val) {
-        if (row < 0 || static_cast<std::vector<int>::size_type>(row) >= matrix.size() || col < 0 || static_cast<std::vector<int>::size_type>(col) >= matrix[0].size()) {
+    template <typename Weight>
+    void BasicGraph<Weight>::setAdjacencyMatrix(int row, int col, Weight val) {
+        if (row < 0 || row >= rows || col < 0 || col >= cols) {
             throw std::out_of_range("Index out of range");
         }
-        matrix[static_cast<std::vector<int>::size_type>(row)][static_cast<std::vector<int>::size_type>(col)] = val;
+        ownCells();
+        std::size_t cell = index(static_cast<std::size_t>(row), static_cast<std::size_t>(col));
+        Weight previous = matrix[cell];
+        bool removesEdge = previous != 0 && val == 0;
+        matrix[cell] = val;
+        edgeCount = edgeCount + (val != 0 ? 1u : 0u) - (previous != 0 ? 1u : 0u);
+        negativeCount = negativeCount + (val < 0 ? 1u : 0u) - (previous < 0 ? 1u : 0u);
+        updateSparseCell(static_cast<std::size_t>(row), static_cast<std::size_t>(col), val);
+        if (!sparse) {
+            if (val != 0) {
+                bitMatrix.set(static_cast<std::size_t>(row), static_cast<std::size_t>(col));
+            } else {
+                bitMatrix.reset(static_cast<std::size_t>(row), static_cast<std::size_t>(col));
+            }
+        }
+
+        if (connectivityTracked) {
+            if (row != col && col < rows && row < cols) {
+                bool reverse = matrix[index(static_cast<std::size_t>(col), static_cast<std::size_t>(row))] != 0;
+                bool wasAsymmetric = (previous != 0) != reverse;
+                bool isAsymmetric = (val != 0) != reverse;
+                if (isAsymmetric && !wasAsymmetric) {
+                    ++asymmetricPairs;
+                } else if (wasAsymmetric && !isAsymmetric) {
+                    --asymmetricPairs;
+                }
+            }
+
+            // A disjoint-set forest cannot split a set, so only removing an edge costs a rebuild
+            if (val != 0) {
+                components.unite(static_cast<std::size_t>(row), static_cast<std::size_t>(col));
+            } else if (removesEdge) {
+                refreshComponents();
+            }
+        }
     }
 
 // Utility functions
@@ -127,36 +684,11 @@ namespace ariel {
  * @return true If the graphs have the same dimensions.
  * @return false If the graphs have different dimensions.
  */
-    bool valid_check(const Graph& graph1, const Graph& graph2) {
+    template <typename Weight>
+    bool valid_check(const BasicGraph<Weight>& graph1, const BasicGraph<Weight>& graph2) {
         return graph1.getRows() == graph2.getRows() && graph1.getCols() == graph2.getCols();
     }
 
-// Unary plus
-/**
- * @brief Unary plus operator for the graph.
- *
- * @return Graph The same graph.
- */
-    Graph Graph::operator+() const {
-        return *this;
-    }
-
-// Unary minus
-/**
- * @brief Unary minus operator for the graph.
- *
- * @return Graph A new graph with all values negated.
- */
-    Graph Graph::operator-() const {
-        Graph result(rows, cols);
-        for (std::vector<int>::size_type i = 0; i < matrix.size(); ++i) {
-            for (std::vector<int>::size_type j = 0; j < matrix[i].size(); ++j) {
-                result.matrix[i][j] = -matrix[i][j];
-            }
-        }
-        return result;
-    }
-
 // Implement operator+=
 /**
  * @brief Addition assignment operator for the graph.
@@ -165,17 +697,16 @@ namespace ariel {
  * @return Graph& Reference to the updated graph.
  * @throws std::runtime_error If the graphs have different dimensions.
  */
-    Graph& Graph::operator+=(const Graph& other) {
+    template <typename Weight>
+    BasicGraph<Weight>& BasicGraph<Weight>::operator+=(const BasicGraph<Weight>& other) {
         if (rows != other.rows || cols != other.cols) {
             throw std::runtime_error("Condition failed: The graphs have different dimensions.");
         }
 
-        for (std::vector<int>::size_type i = 0; i < matrix.size(); ++i) {
-            for (std::vector<int>::size_type j = 0; j < matrix[i].size(); ++j) {
-                matrix[i][j] += other.matrix[i][j];
-            }
-        }
+        ownCells();
+        kernels::addCells(matrix.data(), other.cells(), matrix.size());
 
+        refreshIndexes();
         return *this;
     }
 
@@ -187,16 +718,15 @@ namespace ariel {
  * @return Graph& Reference to the updated graph.
  * @throws std::runtime_error If the graphs have different dimensions.
  */
-    Graph& Graph::operator-=(const Graph& other) {
+    template <typename Weight>
+    BasicGraph<Weight>& BasicGraph<Weight>::operator-=(const BasicGraph<Weight>& other) {
         if (!valid_check(*this, other)) {
             throw std::runtime_error("Condition failed: The graphs have different dimensions.");
         }
 
-        for (std::vector<int>::size_type i = 0; i < matrix.size(); ++i) {
-            for (std::vector<int>::size_type j = 0; j < matrix[i].size(); ++j) {
-                matrix[i][j] -= other.matrix[i][j];
-            }
-        }
+        ownCells();
+        kernels::subtractCells(matrix.data(), other.cells(), matrix.size());
+        refreshIndexes();
         return *this;
     }
 
@@ -206,14 +736,9 @@ namespace ariel {
  *
  * @return Graph& Reference to the updated graph with all non-diagonal elements decremented by 1.
  */
-    Graph& Graph::operator--() {
-        for (std::vector<int>::size_type i = 0; i < rows; ++i) {
-            for (std::vector<int>::size_type j = 0; j < cols; ++j) {
-                if (i != j) {
-                    --matrix[i][j];
-                }
-            }
-        }
+    template <typename Weight>
+    BasicGraph<Weight>& BasicGraph<Weight>::operator--() {
+        offsetOffDiagonal(static_cast<Weight>(-1));
         return *this;
     }
 
@@ -223,25 +748,44 @@ namespace ariel {
  *
  * @return Graph& Reference to the updated graph with all non-diagonal elements incremented by 1.
  */
-    Graph& Graph::operator++() {
-        for (std::vector<int>::size_type i = 0; i < rows; ++i) {
-            for (std::vector<int>::size_type j = 0; j < cols; ++j) {
-                if (i != j) {
-                    ++matrix[i][j];
-                }
-            }
-        }
+    template <typename Weight>
+    BasicGraph<Weight>& BasicGraph<Weight>::operator++() {
+        offsetOffDiagonal(1);
         return *this;
     }
 
+// Shift every off-diagonal cell
+/**
+ * @brief Add delta to every cell but the diagonal. Consecutive diagonal cells are cols + 1 apart,
+ * so the cells between them form one contiguous run that a single kernel call offsets; no cell
+ * pays for an i != j test and nothing is allocated.
+ *
+ * @param delta The amount to add.
+ */
+    template <typename Weight>
+    void BasicGraph<Weight>::offsetOffDiagonal(Weight delta) {
+        ownCells();
+        std::size_t diagonal = static_cast<std::size_t>(std::min(rows, cols));
+        std::size_t total = matrix.size();
+        std::size_t begin = 0; // First cell after the previous diagonal cell
+        for (std::size_t i = 0; i < diagonal; ++i) {
+            std::size_t cell = index(i, i);
+            kernels::offsetCells(matrix.data() + begin, cell - begin, delta);
+            begin = cell + 1;
+        }
+        kernels::offsetCells(matrix.data() + begin, total - begin, delta);
+        refreshIndexes();
+    }
+
 // Implement postfix decrement operator-- (int)
 /**
  * @brief Postfix decrement operator for the graph.
  *
  * @return Graph The graph before the decrement.
  */
-    Graph Graph::operator--(int) {
-        Graph temp = *this;
+    template <typename Weight>
+    BasicGraph<Weight> BasicGraph<Weight>::operator--(int) {
+        BasicGraph<Weight> temp = *this;
         --(*this);
         return temp;
     }
@@ -252,63 +796,13 @@ namespace ariel {
  *
  * @return Graph The graph before the increment.
  */
-    Graph Graph::operator++(int) {
-        Graph temp = *this;
+    template <typename Weight>
+    BasicGraph<Weight> BasicGraph<Weight>::operator++(int) {
+        BasicGraph<Weight> temp = *this;
         ++(*this);
         return temp;
     }
 
-// Implement operator+
-/**
- * @brief Addition operator for two graphs.
- *
- * @param graph1 The first graph.
- * @param graph2 The second graph.
- * @return Graph The result of adding the two graphs.
- * @throws std::runtime_error If the graphs have different dimensions.
- */
-    Graph operator+(const Graph& graph1, const Graph& graph2) {
-        if (!valid_check(graph1, graph2)) {
-            throw std::runtime_error("Condition failed: The graphs have different dimensions.");
-        }
-
-        Graph result = graph1;
-        result += graph2;
-        return result;
-    }
-
-// Implement operator-
-/**
- * @brief Subtraction operator for two graphs.
- *
- * @param graph1 The first graph.
- * @param graph2 The second graph.
- * @return Graph The result of subtracting the second graph from the first graph.
- */
-    Graph operator-(const Graph& graph1, const Graph& graph2) {
-        Graph result = graph1;
-        result -= graph2;
-        return result;
-    }
-
-// Implement operator*
-/**
- * @brief Scalar multiplication operator for the graph.
- *
- * @param scalar The scalar value.
- * @return Graph The result of multiplying the graph by the scalar.
- */
-    Graph Graph::operator*(int scalar) const {
-        Graph result(rows, cols);
-        for (std::vector<int>::size_type i = 0; i < matrix.size(); ++i) {
-            for (std::vector<int>::size_type j = 0; j < matrix[i].size(); ++j) {
-                result.matrix[i][j] = matrix[i][j] * scalar;
-            }
-        }
-
-        return result;
-    }
-
 // Implement operator*=
 /**
  * @brief Scalar multiplication assignment operator for the graph.
@@ -316,12 +810,11 @@ namespace ariel {
  * @param scalar The scalar value.
  * @return Graph& Reference to the updated graph.
  */
-    Graph& Graph::operator*=(int scalar) {
-        for (std::vector<int>::size_type i = 0; i < matrix.size(); ++i) {
-            for (std::vector<int>::size_type j = 0; j < matrix[i].size(); ++j) {
-                matrix[i][j] *= scalar;
-            }
-        }
+    template <typename Weight>
+    BasicGraph<Weight>& BasicGraph<Weight>::operator*=(Weight scalar) {
+        ownCells();
+        kernels::scaleCells(matrix.data(), matrix.size(), scalar);
+        refreshIndexes();
         return *this;
     }
 
@@ -333,35 +826,17 @@ namespace ariel {
  * @return Graph& Reference to the updated graph.
  * @throws std::runtime_error If the scalar value is zero.
  */
-    Graph& Graph::operator/=(int scalar) {
+    template <typename Weight>
+    BasicGraph<Weight>& BasicGraph<Weight>::operator/=(Weight scalar) {
         if (scalar == 0) {
             throw std::runtime_error("Division by zero.");
         }
-        for (std::vector<int>::size_type i = 0; i < matrix.size(); ++i) {
-            for (std::vector<int>::size_type j = 0; j < matrix[i].size(); ++j) {
-                matrix[i][j] /= scalar;
-            }
-        }
+        ownCells();
+        kernels::divideCells(matrix.data(), matrix.size(), scalar);
+        refreshIndexes();
         return *this;
     }
 
-// Scalar division operator
-/**
- * @brief Scalar division operator for the graph.
- *
- * @param scalar The scalar value.
- * @return Graph The result of dividing the graph by the scalar.
- * @throws std::runtime_error If the scalar value is zero.
- */
-    Graph Graph::operator/(int scalar) const {
-        if (scalar == 0) {
-            throw std::runtime_error("Division by zero.");
-        }
-        Graph result(*this);
-        result /= scalar;
-        return result;
-    }
-
 // Implement operator*(Graph)
 /**
  * @brief Matrix multiplication operator for two graphs.
@@ -370,39 +845,88 @@ namespace ariel {
  * @return Graph The result of multiplying the two graphs.
  * @throws std::invalid_argument If the graphs are not square or their dimensions do not match.
  */
-    Graph Graph::operator*(const Graph& other) const {
+    template <typename Weight>
+    BasicGraph<Weight> BasicGraph<Weight>::operator*(const BasicGraph<Weight>& other) const {
         // Check if either matrix is empty
-        if (this->matrix.empty() || other.matrix.empty()) {
-            return Graph(); // Return an empty graph if either matrix is empty
+        if (this->rows == 0 || other.rows == 0) {
+            return BasicGraph<Weight>(); // Return an empty graph if either matrix is empty
         }
 
         // Check if both matrices are square
-        if (this->matrix.size() != this->matrix[0].size() || other.matrix.size() != other.matrix[0].size()) {
+        if (this->rows != this->cols || other.rows != other.cols) {
             throw std::invalid_argument("Both matrices must be square for multiplication.");
         }
 
         // Check if the dimensions of the matrices match for multiplication
-        if (this->matrix.size() != other.matrix.size()) {
+        if (this->rows != other.rows) {
             throw std::invalid_argument("The dimensions of the matrices do not match for multiplication.");
         }
 
-        Graph result;
-        size_t numRows = this->matrix.size();
-        result.matrix.resize(numRows, std::vector<int>(numRows, 0));
+        BasicGraph<Weight> result(rows, cols);
+        size_t numRows = static_cast<size_t>(rows);
 
-        for (size_t i = 0; i < numRows; ++i) {
-            for (size_t j = 0; j < numRows; ++j) {
-                for (size_t k = 0; k < numRows; ++k) {
-                    result.matrix[i][j] += this->matrix[i][k] * other.matrix[k][j];
-                }
-            }
+        // Cache-tiled i-k-j product, vectorized with AVX2 when the CPU has it. Large products
+        // split their output rows across the shared thread pool; each band is written by one thread.
+        const Weight* left = cells();
+        const Weight* right = other.cells();
+        Weight* product = result.matrix.data();
+        if (numRows < PARALLEL_MULTIPLY_MIN_ROWS) {
+            kernels::multiplyAdd(left, right, product, numRows, 0, numRows);
+        } else {
+            ThreadPool::shared().parallelFor(0, numRows, [=](size_t rowBegin, size_t rowEnd) {
+                kernels::multiplyAdd(left, right, product, numRows, rowBegin, rowEnd);
+            });
         }
 
         // Set diagonal elements to zero
         for (size_t i = 0; i < numRows; ++i) {
-            result.matrix[i][i] = 0;
+            result.matrix[result.index(i, i)] = 0;
+        }
+
+        // The product keeps the representation of the left operand
+        result.sparse = sparse;
+        result.connectivityTracked = connectivityTracked;
+        result.refreshIndexes();
+
+        return result;
+    }
+
+// Min-plus product
+/**
+ * @brief Min-plus (tropical) product: result[i][j] = min over k of this[i][k] + other[k][j].
+ *
+ * Both graphs are read as distance matrices: INFINITE_DISTANCE marks a missing entry and every other
+ * value, zero included, is a real length. Squaring a distance matrix doubles the number of edges
+ * its paths may use. The result is dense.
+ *
+ * @param other The right operand.
+ * @return Graph The product; INFINITE_DISTANCE where no k connects i to j.
+ * @throws std::invalid_argument If the graphs are not square or their dimensions do not match.
+ */
+    template <typename Weight>
+    BasicGraph<Weight> BasicGraph<Weight>::minPlus(const BasicGraph<Weight>& other) const {
+        if (this->rows != this->cols || other.rows != other.cols) {
+            throw std::invalid_argument("Both matrices must be square for multiplication.");
+        }
+        if (this->rows != other.rows) {
+            throw std::invalid_argument("The dimensions of the matrices do not match for multiplication.");
         }
 
+        BasicGraph<Weight> result(rows, cols);
+        std::fill(result.matrix.begin(), result.matrix.end(), INFINITE_DISTANCE);
+        size_t numRows = static_cast<size_t>(rows);
+
+        const Weight* left = cells();
+        const Weight* right = other.cells();
+        Weight* product = result.matrix.data();
+        if (numRows < PARALLEL_MULTIPLY_MIN_ROWS) {
+            kernels::minPlus(left, right, product, numRows, 0, numRows, INFINITE_DISTANCE);
+        } else {
+            ThreadPool::shared().parallelFor(0, numRows, [=](size_t rowBegin, size_t rowEnd) {
+                kernels::minPlus(left, right, product, numRows, rowBegin, rowEnd, INFINITE_DISTANCE);
+            });
+        }
+        result.refreshBitMatrix();
         return result;
     }
 
@@ -413,7 +937,9 @@ namespace ariel {
  * @param other The other graph.
  * @return Graph& Reference to the updated graph.
  */
-    Graph& Graph::operator*=(const Graph& other) {
+    template <typename Weight>
+    BasicGraph<Weight>& BasicGraph<Weight>::operator*=(const BasicGraph<Weight>& other) {
+        // Move-assign: take over the product's buffers instead of copying them into *this
         *this = *this * other;
         return *this;
     }
@@ -425,47 +951,14 @@ namespace ariel {
  * @return true If the graphs are equal.
  * @return false If the graphs are not equal.
  */
-    bool Graph::operator==(const Graph& other) const {
+    template <typename Weight>
+    bool BasicGraph<Weight>::operator==(const BasicGraph<Weight>& other) const {
         if (!valid_check(*this, other)) {
             return false;
         }
 
-        // Check if the graphs have the same edges and weights
-        bool same_edges_and_weights = true;
-        for (std::vector<int>::size_type i = 0; i < matrix.size(); ++i) {
-            for (std::vector<int>::size_type j = 0; j < matrix[i].size(); ++j) {
-                if (matrix[i][j] != other.matrix[i][j]) {
-                    same_edges_and_weights = false;
-                    break;
-                }
-            }
-            if (!same_edges_and_weights) {
-                break;
-            }
-        }
-
-        if (same_edges_and_weights) {
-            return true;
-        }
-
-        // Check if G1 is not greater than G2 and G2 is not greater than G1
-        bool g1_not_greater = true;
-        bool g2_not_greater = true;
-        for (std::vector<int>::size_type i = 0; i < matrix.size(); ++i) {
-            for (std::vector<int>::size_type j = 0; j < matrix[i].size(); ++j) {
-                if (matrix[i][j] > other.matrix[i][j]) {
-                    g1_not_greater = false;
-                }
-                if (other.matrix[i][j] > matrix[i][j]) {
-                    g2_not_greater = false;
-                }
-                if (!g1_not_greater && !g2_not_greater) {
-                    return false;
-                }
-            }
-        }
-
-        return g1_not_greater && g2_not_greater;
+        // Same dimensions: the graphs are equal exactly when every edge weight matches
+        return std::equal(cells(), cells() + cellCount(), other.cells());
     }
 
 /**
@@ -475,7 +968,8 @@ namespace ariel {
  * @return true If the graphs are not equal.
  * @return false If the graphs are equal.
  */
-    bool Graph::operator!=(const Graph& other) const {
+    template <typename Weight>
+    bool BasicGraph<Weight>::operator!=(const BasicGraph<Weight>& other) const {
         return !(*this == other);
     }
 
@@ -486,21 +980,17 @@ namespace ariel {
  * @return true If this graph is less than the other graph.
  * @return false Otherwise.
  */
-    bool Graph::operator<(const Graph& other) const {
+    template <typename Weight>
+    bool BasicGraph<Weight>::operator<(const BasicGraph<Weight>& other) const {
         if (rows < other.rows || (rows == other.rows && cols < other.cols)) {
             return true;
         }
-
-        for (std::vector<int>::size_type i = 0; i < matrix.size(); ++i) {
-            for (std::vector<int>::size_type j = 0; j < matrix[i].size(); ++j) {
-                if (matrix[i][j] < other.matrix[i][j]) {
-                    return true;
-                } else if (matrix[i][j] > other.matrix[i][j]) {
-                    return false;
-                }
-            }
+        if (!valid_check(*this, other)) {
+            return false;
         }
-        return false;
+
+        // Same dimensions: compare the row-major cells lexicographically
+        return std::lexicographical_compare(cells(), cells() + cellCount(), other.cells(), other.cells() + other.cellCount());
     }
 
 /**
@@ -510,7 +1000,8 @@ namespace ariel {
  * @return true If this graph is less than or equal to the other graph.
  * @return false Otherwise.
  */
-    bool Graph::operator<=(const Graph& other) const {
+    template <typename Weight>
+    bool BasicGraph<Weight>::operator<=(const BasicGraph<Weight>& other) const {
         return *this < other || *this == other;
     }
 
@@ -521,7 +1012,8 @@ namespace ariel {
  * @return true If this graph is greater than the other graph.
  * @return false Otherwise.
  */
-    bool Graph::operator>(const Graph& other) const {
+    template <typename Weight>
+    bool BasicGraph<Weight>::operator>(const BasicGraph<Weight>& other) const {
         return !(*this <= other);
     }
 
@@ -532,7 +1024,8 @@ namespace ariel {
  * @return true If this graph is greater than or equal to the other graph.
  * @return false Otherwise.
  */
-    bool Graph::operator>=(const Graph& other) const {
+    template <typename Weight>
+    bool BasicGraph<Weight>::operator>=(const BasicGraph<Weight>& other) const {
         return !(*this < other);
     }
 
@@ -544,15 +1037,17 @@ namespace ariel {
  * @param graph The graph to print.
  * @return std::ostream& Reference to the output stream.
  */
-    std::ostream& operator<<(std::ostream& output, const Graph& graph) {
-        for (const auto& row : graph.matrix) {
+    template <typename Weight>
+    std::ostream& operator<<(std::ostream& output, const BasicGraph<Weight>& graph) {
+        const BasicMatrixView<Weight> view = graph.getAdjacencyMatrix();
+        for (std::size_t r = 0; r < view.size(); ++r) {
             output << "[";
             bool first = true;
-            for (int val : row) {
+            for (Weight val : view[r]) {
                 if (!first) {
                     output << ", ";
                 }
-                output << val;
+                output << +val; // Unary plus prints byte weights as numbers, not characters
                 first = false;
             }
             output << "]" << std::endl; // Make sure to print a newline after each row
@@ -569,36 +1064,27 @@ namespace ariel {
  * @return Graph The result of dividing the scalar by the graph.
  * @throws std::runtime_error If the scalar value is zero.
  */
-    Graph operator/(int scalar, const Graph& graph) {
+    template <typename Weight>
+    BasicGraph<Weight> operator/(typename BasicGraph<Weight>::WeightType scalar, const BasicGraph<Weight>& graph) {
         if (scalar == 0) {
             throw std::runtime_error("Division by zero: scalar is zero.");
         }
 
-        Graph result(graph);
-        std::vector<std::vector<int>> adjacencyMatrix = result.getAdjacencyMatrix();
-
-        for (std::vector<int>::size_type i = 0; i < adjacencyMatrix.size(); ++i) {
-            for (std::vector<int>::size_type j = 0; j < adjacencyMatrix[i].size(); ++j) {
-                if (adjacencyMatrix[i][j] != 0) {
-                    adjacencyMatrix[i][j] = scalar / adjacencyMatrix[i][j];
-                }
-            }
-        }
-
-        result.loadGraph(adjacencyMatrix);
+        // Zero cells stay zero, so the copy's edge set and representation carry over
+        BasicGraph<Weight> result(graph);
+        result.ownCells();
+        kernels::divideScalarByCells(scalar, result.matrix.data(), result.matrix.data(), result.matrix.size());
+        result.refreshIndexes();
         return result;
     }
 
-// Scalar multiplication operator (scalar * graph)
-/**
- * @brief Scalar multiplication operator for a scalar and a graph.
- *
- * @param scalar The scalar value.
- * @param graph The graph to multiply.
- * @return Graph The result of multiplying the scalar by the graph.
- */
-    Graph operator*(int scalar, const Graph& graph) {
-        return graph * scalar;
-    }
+// Explicit instantiations for every supported weight type
+#define ARIEL_INSTANTIATE_GRAPH(Weight)                                                              \
+    template class BasicGraph<Weight>;                                                              \
+    template bool valid_check(const BasicGraph<Weight>&, const BasicGraph<Weight>&);                \
+    template BasicGraph<Weight> operator/<Weight>(Weight, const BasicGraph<Weight>&);               \
+    template std::ostream& operator<<(std::ostream&, const BasicGraph<Weight>&);
+
+    ARIEL_FOR_EACH_WEIGHT(ARIEL_INSTANTIATE_GRAPH)
 
 } // namespace ariel
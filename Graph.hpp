@@ -3,88 +3,530 @@
 
 #include <vector>
 #include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <limits>
+#include <stdexcept>
+#include "Kernels.hpp"
 
 namespace ariel {
 
-    class Graph {
+    // Read-only view of a single row of a graph's adjacency matrix
+    template <typename Weight>
+    class BasicRowView {
+    private:
+        const Weight* cells;
+        std::size_t length;
+
+    public:
+        BasicRowView(const Weight* cells, std::size_t length) : cells(cells), length(length) {}
+
+        const Weight& operator[](std::size_t col) const { return cells[col]; }
+        std::size_t size() const { return length; }
+        const Weight* begin() const { return cells; }
+        const Weight* end() const { return cells + length; }
+    };
+
+    // Read-only, row-indexable view of a graph's contiguous adjacency matrix
+    template <typename Weight>
+    class BasicMatrixView {
+    private:
+        const Weight* cells;
+        std::size_t rows;
+        std::size_t cols;
+
+    public:
+        BasicMatrixView(const Weight* cells, std::size_t rows, std::size_t cols) : cells(cells), rows(rows), cols(cols) {}
+
+        BasicRowView<Weight> operator[](std::size_t row) const { return BasicRowView<Weight>(cells + row * cols, cols); }
+        std::size_t size() const { return rows; }
+        bool empty() const { return rows == 0; }
+        const Weight* data() const { return cells; }
+
+        // Copy the viewed cells into a nested vector
+        operator std::vector<std::vector<Weight>>() const {
+            std::vector<std::vector<Weight>> nested;
+            nested.reserve(rows);
+            for (std::size_t i = 0; i < rows; ++i) {
+                nested.emplace_back(cells + i * cols, cells + (i + 1) * cols);
+            }
+            return nested;
+        }
+    };
+
+    // Adjacency matrix packed to one bit per cell (set for non-zero weights), 64 columns per word
+    class BitMatrix {
+    private:
+        std::size_t rows;
+        std::size_t cols;
+        std::size_t wordsPerRow;
+        std::vector<std::uint64_t> words;
+
+    public:
+        static const std::size_t WORD_BITS = 64;
+
+        BitMatrix(std::size_t rows, std::size_t cols);
+
+        void set(std::size_t row, std::size_t col) { words[row * wordsPerRow + col / WORD_BITS] |= std::uint64_t(1) << (col % WORD_BITS); }
+        void reset(std::size_t row, std::size_t col) { words[row * wordsPerRow + col / WORD_BITS] &= ~(std::uint64_t(1) << (col % WORD_BITS)); }
+        bool test(std::size_t row, std::size_t col) const { return (words[row * wordsPerRow + col / WORD_BITS] >> (col % WORD_BITS)) & 1U; }
+        const std::uint64_t* row(std::size_t row) const { return words.data() + row * wordsPerRow; }
+
+        std::size_t size() const { return rows; }
+        std::size_t getCols() const { return cols; }
+        std::size_t getWordsPerRow() const { return wordsPerRow; }
+    };
+
+    // How the algorithms traverse a graph's edges. Either way the graph stores the full rows x cols
+    // matrix: Sparse adds a CSR index on top of it for O(V+E) traversal and does not reduce storage.
+    enum class Representation {
+        Auto,   // Pick Sparse or Dense from the edge density when the graph is loaded
+        Dense,  // Scan full adjacency matrix rows
+        Sparse  // Walk a compressed sparse row (CSR) index of the non-zero cells
+    };
+
+    // Compressed sparse row adjacency: the edges leaving vertex v are
+    // neighbors[offsets[v]] .. neighbors[offsets[v + 1] - 1], with matching weights
+    template <typename Weight>
+    struct BasicSparseAdjacency {
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> neighbors;
+        std::vector<Weight> weights;
+    };
+
+    // Disjoint-set forest with union by rank and path compression; counts its sets
+    class DisjointSets {
+    private:
+        std::vector<std::size_t> parent;
+        std::vector<unsigned char> rank; // Upper bound on tree height, at most log2(size)
+        std::size_t sets;
+
+    public:
+        DisjointSets() : sets(0) {}
+        explicit DisjointSets(std::size_t size);
+
+        // Representative of the set holding element
+        std::size_t find(std::size_t element);
+
+        // Merge the sets of a and b; returns false if they were already one set
+        bool unite(std::size_t a, std::size_t b);
+
+        bool connected(std::size_t a, std::size_t b) { return find(a) == find(b); }
+        std::size_t size() const { return parent.size(); }
+        std::size_t count() const { return sets; }
+    };
+
+    template <typename Weight>
+    class BasicGraph;
+
+    // Base of the lazy element-wise expressions built by +, -, unary minus, and scalar * and /
+    // (defined below BasicGraph). Expression is the concrete node type; it provides getRows(),
+    // getCols(), cell(i) for row-major cell i, and leaf(), the left-most graph operand.
+    template <typename Weight, typename Expression>
+    class GraphExpression {
+    public:
+        const Expression& derived() const { return static_cast<const Expression&>(*this); }
+    };
+
+    // Graph over an adjacency matrix of Weight cells, where zero means "no edge". The library is
+    // compiled for the types listed in ARIEL_FOR_EACH_WEIGHT; Graph is the int instantiation.
+    template <typename Weight>
+    class BasicGraph : public GraphExpression<Weight, BasicGraph<Weight>> {
     private:
         int rows;
         int cols;
-        std::vector<std::vector<int>> matrix;
+        std::vector<Weight> matrix; // Row-major, rows * cols cells; empty while borrowed is set
+        const Weight* borrowed;     // Caller-owned row-major cells viewed in place, or null when matrix holds them
+        bool sparse;                // Whether sparseAdjacency mirrors matrix
+        BasicSparseAdjacency<Weight> sparseAdjacency;
+        BasicSparseAdjacency<Weight> reverseSparseAdjacency; // Transpose of sparseAdjacency: the edges entering each vertex
+        BitMatrix bitMatrix;        // Edge bits of matrix; mirrors it while the graph is dense, 0 x 0 otherwise
+        bool connectivityTracked; // Whether components mirrors matrix
+        DisjointSets components;  // Vertices joined by an edge in either direction
+        std::size_t asymmetricPairs; // Vertex pairs with an edge in one direction only, counted along with components
+        std::size_t edgeCount;       // Non-zero cells, counted by every index rebuild and kept current by setAdjacencyMatrix
+        std::size_t negativeCount;   // Negative cells, counted along with edgeCount
+
+        std::size_t index(std::size_t row, std::size_t col) const { return row * static_cast<std::size_t>(cols) + col; }
+        std::size_t cellCount() const { return static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols); }
+
+        // The row-major cells, wherever they live
+        const Weight* cells() const { return borrowed != nullptr ? borrowed : matrix.data(); }
+
+        // Copy borrowed cells into matrix; every write calls this first
+        void ownCells();
+
+        // Rebuild the CSR indexes from matrix if this graph is sparse
+        void refreshSparseAdjacency();
+
+        // Rebuild the bit matrix from matrix if this graph is dense, release it otherwise
+        void refreshBitMatrix();
+
+        // Patch a single cell of the CSR indexes if this graph is sparse
+        void updateSparseCell(std::size_t row, std::size_t col, Weight val);
+
+        // Rebuild the connected components from matrix if connectivity is tracked
+        void refreshComponents();
+
+        // Rebuild every index derived from matrix
+        void refreshIndexes();
+
+        // Recount edgeCount and negativeCount from matrix
+        void countCells();
+
+        // Add delta to every cell off the diagonal (the ++ and -- operators)
+        void offsetOffDiagonal(Weight delta);
+
+        // Overwrite this graph with the cells of expression in a single pass
+        template <typename Expression>
+        void assignExpression(const Expression& expression);
+
+        template <typename Other>
+        friend BasicGraph<Other> operator/(typename BasicGraph<Other>::WeightType scalar, const BasicGraph<Other>& graph);
 
     public:
+        typedef Weight WeightType;
+
+        // Cell value marking a missing entry in distance matrices (see minPlus): infinity for
+        // floating-point weights, the largest value otherwise
+        static constexpr Weight INFINITE_DISTANCE = std::numeric_limits<Weight>::has_infinity ? std::numeric_limits<Weight>::infinity() : std::numeric_limits<Weight>::max();
+
         // Constructor with dimensions
-        Graph(int rows, int cols);
+        BasicGraph(int rows, int cols);
 
         // Default constructor
-        Graph();
+        BasicGraph();
+
+        // Copy and move; a moved-from graph is left empty (0 x 0)
+        BasicGraph(const BasicGraph& other) = default;
+        BasicGraph(BasicGraph&& other) noexcept;
+        BasicGraph& operator=(const BasicGraph& other) = default;
+        BasicGraph& operator=(BasicGraph&& other) noexcept;
+
+        // Evaluate an element-wise expression such as (g1 + g2) * 3 - g4 in one fused pass. The
+        // result takes its representation and connectivity tracking from the left-most graph.
+        template <typename Expression>
+        BasicGraph(const GraphExpression<Weight, Expression>& expression);
+        template <typename Expression>
+        BasicGraph& operator=(const GraphExpression<Weight, Expression>& expression);
 
         // Destructor
-        ~Graph();
+        ~BasicGraph();
+
+        // Load graph from an adjacency matrix; the rvalue overload frees each input row once it is copied
+        void loadGraph(const std::vector<std::vector<Weight>>& adjacencyMatrix, Representation representation = Representation::Auto);
+        void loadGraph(std::vector<std::vector<Weight>>&& adjacencyMatrix, Representation representation = Representation::Auto);
+
+        // Adopt a flat row-major buffer of rows * cols cells without copying it
+        void loadGraph(std::vector<Weight>&& cells, int rows, int cols, Representation representation = Representation::Auto);
 
-        // Load graph from an adjacency matrix
-        void loadGraph(const std::vector<std::vector<int>>& adjacencyMatrix);
+        // View caller-owned cells in place, rows of cols cells stride cells apart. A tight buffer
+        // (stride == cols) is not copied and must outlive the graph or its next load; the first write
+        // copies it (copies of the graph share it until then). Padded rows are packed into owned storage.
+        void loadGraph(const Weight* cells, int rows, int cols, int stride, Representation representation = Representation::Auto);
+
+        // Whether the cells are a caller-owned buffer rather than the graph's own
+        bool isView() const { return borrowed != nullptr; }
+
+        // Switch the traversal representation, building or dropping the CSR index. Auto decides from
+        // the edge count the graph keeps, without rescanning the matrix.
+        void setRepresentation(Representation representation);
 
         // Print the graph
         std::string printGraph() const;
 
-        // Get adjacency matrix
-        const std::vector<std::vector<int>>& getAdjacencyMatrix() const;
+        // Get a row-indexable view of the adjacency matrix
+        BasicMatrixView<Weight> getAdjacencyMatrix() const;
+
+        // Get the bit matrix of the edges, kept current like the CSR index; 0 x 0 unless the graph is dense
+        const BitMatrix& getBitMatrix() const { return bitMatrix; }
 
         // Set a specific value in the adjacency matrix
-        void setAdjacencyMatrix(int row, int col, int val);
+        void setAdjacencyMatrix(int row, int col, Weight val);
 
         // Getters
         int getRows() const { return rows; }
         int getCols() const { return cols; }
+        bool isSparse() const { return sparse; }
 
-        // Unary operators
-        Graph operator+() const;
-        Graph operator-() const;
+        // Number of non-zero cells, and whether any of them is negative; both kept current, O(1)
+        std::size_t getEdgeCount() const { return edgeCount; }
+        bool hasNegativeWeight() const { return negativeCount != 0; }
+
+        // Get the CSR index; empty unless isSparse()
+        const BasicSparseAdjacency<Weight>& getSparseAdjacency() const { return sparseAdjacency; }
+
+        // Get the transposed CSR index (incoming edges); empty unless isSparse()
+        const BasicSparseAdjacency<Weight>& getReverseSparseAdjacency() const { return reverseSparseAdjacency; }
+
+        // Keep the connected components in a disjoint-set forest that every edge insertion updates
+        void setConnectivityTracking(bool enabled);
+        bool tracksConnectivity() const { return connectivityTracked; }
+
+        // Get the tracked components; empty unless tracksConnectivity()
+        const DisjointSets& getComponents() const { return components; }
+
+        // Whether every edge has a reverse edge, so the tracked components are also what a traversal
+        // from any vertex reaches; only maintained while tracksConnectivity()
+        bool isSymmetric() const { return asymmetricPairs == 0; }
 
         // Compound assignment operators
-        Graph& operator+=(const Graph& other);
-        Graph& operator-=(const Graph& other);
-        Graph& operator*=(int scalar);
-        Graph& operator/=(int scalar);
-        Graph& operator*=(const Graph& other);
+        BasicGraph& operator+=(const BasicGraph& other);
+        BasicGraph& operator-=(const BasicGraph& other);
+        template <typename Expression>
+        BasicGraph& operator+=(const GraphExpression<Weight, Expression>& expression);
+        template <typename Expression>
+        BasicGraph& operator-=(const GraphExpression<Weight, Expression>& expression);
+        BasicGraph& operator*=(Weight scalar);
+        BasicGraph& operator/=(Weight scalar);
+        BasicGraph& operator*=(const BasicGraph& other);
 
         // Increment and decrement operators
-        Graph& operator++();    // Prefix increment
-        Graph operator++(int); // Postfix increment
-        Graph& operator--();    // Prefix decrement
-        Graph operator--(int); // Postfix decrement
+        BasicGraph& operator++();    // Prefix increment
+        BasicGraph operator++(int); // Postfix increment
+        BasicGraph& operator--();    // Prefix decrement
+        BasicGraph operator--(int); // Postfix decrement
 
         // Comparison operators
-        bool operator==(const Graph& other) const;
-        bool operator!=(const Graph& other) const;
-        bool operator<(const Graph& other) const;
-        bool operator<=(const Graph& other) const;
-        bool operator>(const Graph& other) const;
-        bool operator>=(const Graph& other) const;
+        bool operator==(const BasicGraph& other) const;
+        bool operator!=(const BasicGraph& other) const;
+        bool operator<(const BasicGraph& other) const;
+        bool operator<=(const BasicGraph& other) const;
+        bool operator>(const BasicGraph& other) const;
+        bool operator>=(const BasicGraph& other) const;
+
+        // Matrix product
+        BasicGraph operator*(const BasicGraph& other) const;
 
-        // Arithmetic operators
-        Graph operator*(int scalar) const;
-        Graph operator/(int scalar) const;
-        Graph operator*(const Graph& other) const;
+        // Min-plus (tropical) product of two distance matrices
+        BasicGraph minPlus(const BasicGraph& other) const;
+    };
 
-        // Complementation operator
+// Utility functions
+    template <typename Weight>
+    bool valid_check(const BasicGraph<Weight>& graph1, const BasicGraph<Weight>& graph2);
 
+// Scalar divided by every edge weight; the scalar converts to the graph's weight type
+    template <typename Weight>
+    BasicGraph<Weight> operator/(typename BasicGraph<Weight>::WeightType scalar, const BasicGraph<Weight>& graph);
 
-        // Friend function for output
-        friend std::ostream& operator<<(std::ostream& output, const Graph& graph);
+// Output
+    template <typename Weight>
+    std::ostream& operator<<(std::ostream& output, const BasicGraph<Weight>& graph);
+
+// Lazy element-wise expressions. +, -, unary minus, and scalar * and / build a tree of nodes
+// that is only evaluated when assigned to a graph, in one pass with no intermediate matrices.
+// Graph operands are held by reference, so evaluate an expression before its graphs go away.
+
+    // Leaf of an expression: the cells of one graph
+    template <typename Weight>
+    class GraphLeaf {
+    private:
+        const BasicGraph<Weight>* graph;
+        const Weight* cells;
+
+    public:
+        explicit GraphLeaf(const BasicGraph<Weight>& graph) : graph(&graph), cells(graph.getAdjacencyMatrix().data()) {}
+
+        int getRows() const { return graph->getRows(); }
+        int getCols() const { return graph->getCols(); }
+        Weight cell(std::size_t i) const { return cells[i]; }
+        const BasicGraph<Weight>& leaf() const { return *graph; }
     };
 
-// Utility functions
-    bool valid_check(const Graph& graph1, const Graph& graph2);
+    // How a node holds an operand: graphs through a GraphLeaf, nested nodes by value
+    template <typename Weight, typename Expression>
+    struct ExpressionOperand {
+        typedef Expression type;
+    };
+
+    template <typename Weight>
+    struct ExpressionOperand<Weight, BasicGraph<Weight>> {
+        typedef GraphLeaf<Weight> type;
+    };
+
+    // Cell-wise combination of two expressions of the same dimensions
+    template <typename Weight, typename Left, typename Right, typename Combine>
+    class GraphBinaryExpression : public GraphExpression<Weight, GraphBinaryExpression<Weight, Left, Right, Combine>> {
+    private:
+        typename ExpressionOperand<Weight, Left>::type left;
+        typename ExpressionOperand<Weight, Right>::type right;
+
+    public:
+        GraphBinaryExpression(const GraphExpression<Weight, Left>& left, const GraphExpression<Weight, Right>& right)
+                : left(left.derived()), right(right.derived()) {
+            if (this->left.getRows() != this->right.getRows() || this->left.getCols() != this->right.getCols()) {
+                throw std::runtime_error("Condition failed: The graphs have different dimensions.");
+            }
+        }
+
+        int getRows() const { return left.getRows(); }
+        int getCols() const { return left.getCols(); }
+        Weight cell(std::size_t i) const { return Combine::apply(left.cell(i), right.cell(i)); }
+        const BasicGraph<Weight>& leaf() const { return left.leaf(); }
+    };
+
+    // One expression with map applied to every cell
+    template <typename Weight, typename Operand, typename Map>
+    class GraphMapExpression : public GraphExpression<Weight, GraphMapExpression<Weight, Operand, Map>> {
+    private:
+        typename ExpressionOperand<Weight, Operand>::type operand;
+        Map map;
+
+    public:
+        GraphMapExpression(const GraphExpression<Weight, Operand>& operand, Map map) : operand(operand.derived()), map(map) {}
+
+        int getRows() const { return operand.getRows(); }
+        int getCols() const { return operand.getCols(); }
+        Weight cell(std::size_t i) const { return map(operand.cell(i)); }
+        const BasicGraph<Weight>& leaf() const { return operand.leaf(); }
+    };
+
+    template <typename Weight>
+    struct AddCells {
+        static Weight apply(Weight a, Weight b) { return static_cast<Weight>(a + b); }
+    };
+
+    template <typename Weight>
+    struct SubtractCells {
+        static Weight apply(Weight a, Weight b) { return static_cast<Weight>(a - b); }
+    };
+
+    template <typename Weight>
+    struct NegateCell {
+        Weight operator()(Weight cell) const { return static_cast<Weight>(-cell); }
+    };
+
+    template <typename Weight>
+    struct ScaleCell {
+        Weight scalar;
+        Weight operator()(Weight cell) const { return static_cast<Weight>(cell * scalar); }
+    };
+
+    template <typename Weight>
+    struct DivideCell {
+        kernels::InvariantDivisor<Weight> divisor;
+        Weight operator()(Weight cell) const { return divisor.divide(cell); }
+    };
+
+// Element-wise operators; the scalar converts to the graph's weight type
+    template <typename Weight, typename Left, typename Right>
+    GraphBinaryExpression<Weight, Left, Right, AddCells<Weight>> operator+(const GraphExpression<Weight, Left>& left, const GraphExpression<Weight, Right>& right) {
+        return GraphBinaryExpression<Weight, Left, Right, AddCells<Weight>>(left, right);
+    }
+
+    template <typename Weight, typename Left, typename Right>
+    GraphBinaryExpression<Weight, Left, Right, SubtractCells<Weight>> operator-(const GraphExpression<Weight, Left>& left, const GraphExpression<Weight, Right>& right) {
+        return GraphBinaryExpression<Weight, Left, Right, SubtractCells<Weight>>(left, right);
+    }
+
+    template <typename Weight, typename Expression>
+    const Expression& operator+(const GraphExpression<Weight, Expression>& expression) {
+        return expression.derived();
+    }
+
+    template <typename Weight, typename Expression>
+    GraphMapExpression<Weight, Expression, NegateCell<Weight>> operator-(const GraphExpression<Weight, Expression>& expression) {
+        return GraphMapExpression<Weight, Expression, NegateCell<Weight>>(expression, NegateCell<Weight>());
+    }
+
+    template <typename Weight, typename Expression>
+    GraphMapExpression<Weight, Expression, ScaleCell<Weight>> operator*(const GraphExpression<Weight, Expression>& expression, typename BasicGraph<Weight>::WeightType scalar) {
+        return GraphMapExpression<Weight, Expression, ScaleCell<Weight>>(expression, ScaleCell<Weight>{scalar});
+    }
+
+    template <typename Weight, typename Expression>
+    GraphMapExpression<Weight, Expression, ScaleCell<Weight>> operator*(typename BasicGraph<Weight>::WeightType scalar, const GraphExpression<Weight, Expression>& expression) {
+        return GraphMapExpression<Weight, Expression, ScaleCell<Weight>>(expression, ScaleCell<Weight>{scalar});
+    }
+
+    template <typename Weight, typename Expression>
+    GraphMapExpression<Weight, Expression, DivideCell<Weight>> operator/(const GraphExpression<Weight, Expression>& expression, typename BasicGraph<Weight>::WeightType scalar) {
+        if (scalar == 0) {
+            throw std::runtime_error("Division by zero.");
+        }
+        return GraphMapExpression<Weight, Expression, DivideCell<Weight>>(expression, DivideCell<Weight>{kernels::InvariantDivisor<Weight>(scalar)});
+    }
+
+    // Matrix product with an expression on the left: evaluates it first
+    template <typename Weight, typename Expression>
+    BasicGraph<Weight> operator*(const GraphExpression<Weight, Expression>& left, const BasicGraph<Weight>& right) {
+        return BasicGraph<Weight>(left) * right;
+    }
+
+    template <typename Weight>
+    template <typename Expression>
+    BasicGraph<Weight>::BasicGraph(const GraphExpression<Weight, Expression>& expression)
+            : rows(0), cols(0), borrowed(nullptr), sparse(false), bitMatrix(0, 0), connectivityTracked(false), asymmetricPairs(0),
+              edgeCount(0), negativeCount(0) {
+        assignExpression(expression.derived());
+    }
+
+    template <typename Weight>
+    template <typename Expression>
+    BasicGraph<Weight>& BasicGraph<Weight>::operator=(const GraphExpression<Weight, Expression>& expression) {
+        assignExpression(expression.derived());
+        return *this;
+    }
+
+    template <typename Weight>
+    template <typename Expression>
+    BasicGraph<Weight>& BasicGraph<Weight>::operator+=(const GraphExpression<Weight, Expression>& expression) {
+        return *this = *this + expression;
+    }
+
+    template <typename Weight>
+    template <typename Expression>
+    BasicGraph<Weight>& BasicGraph<Weight>::operator-=(const GraphExpression<Weight, Expression>& expression) {
+        return *this = *this - expression;
+    }
+
+    template <typename Weight>
+    template <typename Expression>
+    void BasicGraph<Weight>::assignExpression(const Expression& expression) {
+        const BasicGraph<Weight>& source = expression.leaf();
+        bool sourceSparse = source.sparse;
+        bool sourceTracked = source.connectivityTracked;
+        int resultRows = expression.getRows();
+        int resultCols = expression.getCols();
+
+        // Every graph the expression reads has the result's dimensions, so when this graph is
+        // one of them the resize keeps its buffer and each cell is read before it is written
+        std::size_t cells = static_cast<std::size_t>(resultRows) * static_cast<std::size_t>(resultCols);
+        matrix.resize(cells);
+        Weight* out = matrix.data();
+        for (std::size_t i = 0; i < cells; ++i) {
+            out[i] = expression.cell(i);
+        }
+        borrowed = nullptr; // A borrowed buffer was only read; matrix now holds the result
+
+        rows = resultRows;
+        cols = resultCols;
+        sparse = sourceSparse;
+        connectivityTracked = sourceTracked;
+        refreshIndexes();
+    }
+
+// Weight types the library is compiled for; MACRO(type) is expanded once per type
+#define ARIEL_FOR_EACH_WEIGHT(MACRO) \
+    MACRO(std::int8_t)               \
+    MACRO(std::uint8_t)              \
+    MACRO(std::int16_t)              \
+    MACRO(std::int32_t)              \
+    MACRO(std::int64_t)              \
+    MACRO(float)                     \
+    MACRO(double)
+
+// Instantiated once, in Graph.cpp
+#define ARIEL_DECLARE_GRAPH(Weight) extern template class BasicGraph<Weight>;
 
-// Binary arithmetic operators
-    Graph operator+(const Graph& graph1, const Graph& graph2);
-    Graph operator-(const Graph& graph1, const Graph& graph2);
+    ARIEL_FOR_EACH_WEIGHT(ARIEL_DECLARE_GRAPH)
 
-// Scalar arithmetic operators
-    Graph operator*(int scalar, const Graph& graph);
-    Graph operator/(int scalar, const Graph& graph);
+    typedef BasicGraph<int> Graph;
+    typedef BasicMatrixView<int> MatrixView;
+    typedef BasicRowView<int> RowView;
+    typedef BasicSparseAdjacency<int> SparseAdjacency;
 
 } // namespace ariel
 
@@ -0,0 +1,641 @@
+#include "Kernels.hpp"
+#include "Graph.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARIEL_HAS_AVX2_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace ariel {
+    namespace kernels {
+
+        namespace {
+            // Tile edge in cells: one 64x64 tile of each int operand (3 x 16 KiB) stays cache resident
+            const std::size_t TILE = 64;
+
+            typedef void (*MultiplyKernel)(const int*, const int*, int*, std::size_t, std::size_t, std::size_t);
+
+            // Portable i-k-j kernel: the innermost loop walks rows of b and c contiguously,
+            // and zero cells of a (missing edges) skip a whole row update
+            template <typename Weight>
+            void multiplyAddScalar(const Weight* a, const Weight* b, Weight* c, std::size_t n, std::size_t rowBegin, std::size_t rowEnd) {
+                for (std::size_t ii = rowBegin; ii < rowEnd; ii += TILE) {
+                    std::size_t iEnd = std::min(ii + TILE, rowEnd);
+                    for (std::size_t kk = 0; kk < n; kk += TILE) {
+                        std::size_t kEnd = std::min(kk + TILE, n);
+                        for (std::size_t jj = 0; jj < n; jj += TILE) {
+                            std::size_t jEnd = std::min(jj + TILE, n);
+                            for (std::size_t i = ii; i < iEnd; ++i) {
+                                for (std::size_t k = kk; k < kEnd; ++k) {
+                                    Weight aik = a[i * n + k];
+                                    if (aik == 0) {
+                                        continue;
+                                    }
+                                    const Weight* bRow = b + k * n;
+                                    Weight* cRow = c + i * n;
+                                    for (std::size_t j = jj; j < jEnd; ++j) {
+                                        cRow[j] = static_cast<Weight>(cRow[j] + aik * bRow[j]);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+#ifdef ARIEL_HAS_AVX2_KERNELS
+            // AVX2 kernel: inside each tile a 4 x 16 block of c lives in eight ymm accumulators
+            // for the whole k loop; rows and columns left over at the tile edges go scalar
+            __attribute__((target("avx2")))
+            void multiplyAddAvx2(const int* a, const int* b, int* c, std::size_t n, std::size_t rowBegin, std::size_t rowEnd) {
+                for (std::size_t ii = rowBegin; ii < rowEnd; ii += TILE) {
+                    std::size_t iEnd = std::min(ii + TILE, rowEnd);
+                    for (std::size_t kk = 0; kk < n; kk += TILE) {
+                        std::size_t kEnd = std::min(kk + TILE, n);
+                        for (std::size_t jj = 0; jj < n; jj += TILE) {
+                            std::size_t jEnd = std::min(jj + TILE, n);
+                            std::size_t i = ii;
+                            for (; i + 4 <= iEnd; i += 4) {
+                                int* c0 = c + i * n;
+                                int* c1 = c0 + n;
+                                int* c2 = c1 + n;
+                                int* c3 = c2 + n;
+                                std::size_t j = jj;
+                                for (; j + 16 <= jEnd; j += 16) {
+                                    __m256i acc00 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c0 + j));
+                                    __m256i acc01 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c0 + j + 8));
+                                    __m256i acc10 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c1 + j));
+                                    __m256i acc11 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c1 + j + 8));
+                                    __m256i acc20 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c2 + j));
+                                    __m256i acc21 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c2 + j + 8));
+                                    __m256i acc30 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c3 + j));
+                                    __m256i acc31 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c3 + j + 8));
+                                    for (std::size_t k = kk; k < kEnd; ++k) {
+                                        const int* bRow = b + k * n + j;
+                                        __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow));
+                                        __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow + 8));
+                                        __m256i a0 = _mm256_set1_epi32(a[i * n + k]);
+                                        __m256i a1 = _mm256_set1_epi32(a[(i + 1) * n + k]);
+                                        __m256i a2 = _mm256_set1_epi32(a[(i + 2) * n + k]);
+                                        __m256i a3 = _mm256_set1_epi32(a[(i + 3) * n + k]);
+                                        acc00 = _mm256_add_epi32(acc00, _mm256_mullo_epi32(a0, b0));
+                                        acc01 = _mm256_add_epi32(acc01, _mm256_mullo_epi32(a0, b1));
+                                        acc10 = _mm256_add_epi32(acc10, _mm256_mullo_epi32(a1, b0));
+                                        acc11 = _mm256_add_epi32(acc11, _mm256_mullo_epi32(a1, b1));
+                                        acc20 = _mm256_add_epi32(acc20, _mm256_mullo_epi32(a2, b0));
+                                        acc21 = _mm256_add_epi32(acc21, _mm256_mullo_epi32(a2, b1));
+                                        acc30 = _mm256_add_epi32(acc30, _mm256_mullo_epi32(a3, b0));
+                                        acc31 = _mm256_add_epi32(acc31, _mm256_mullo_epi32(a3, b1));
+                                    }
+                                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(c0 + j), acc00);
+                                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(c0 + j + 8), acc01);
+                                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(c1 + j), acc10);
+                                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(c1 + j + 8), acc11);
+                                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(c2 + j), acc20);
+                                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(c2 + j + 8), acc21);
+                                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(c3 + j), acc30);
+                                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(c3 + j + 8), acc31);
+                                }
+                                // Columns past the last full 16-wide block
+                                for (std::size_t r = i; r < i + 4; ++r) {
+                                    for (std::size_t k = kk; k < kEnd; ++k) {
+                                        int ark = a[r * n + k];
+                                        for (std::size_t jr = j; jr < jEnd; ++jr) {
+                                            c[r * n + jr] += ark * b[k * n + jr];
+                                        }
+                                    }
+                                }
+                            }
+                            // Rows past the last full 4-row block
+                            for (; i < iEnd; ++i) {
+                                for (std::size_t k = kk; k < kEnd; ++k) {
+                                    int aik = a[i * n + k];
+                                    for (std::size_t j = jj; j < jEnd; ++j) {
+                                        c[i * n + j] += aik * b[k * n + j];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+#endif
+
+            MultiplyKernel selectMultiplyKernel() {
+#ifdef ARIEL_HAS_AVX2_KERNELS
+                if (__builtin_cpu_supports("avx2")) {
+                    return multiplyAddAvx2;
+                }
+#endif
+                return multiplyAddScalar<int>;
+            }
+
+            // Chosen once, on first use
+            MultiplyKernel multiplyKernel() {
+                static const MultiplyKernel kernel = selectMultiplyKernel();
+                return kernel;
+            }
+
+            template <typename Weight>
+            void multiplyAddForType(const Weight* a, const Weight* b, Weight* c, std::size_t n, std::size_t rowBegin, std::size_t rowEnd) {
+                multiplyAddScalar(a, b, c, n, rowBegin, rowEnd);
+            }
+
+            // int products go through the kernel picked for this CPU
+            void multiplyAddForType(const int* a, const int* b, int* c, std::size_t n, std::size_t rowBegin, std::size_t rowEnd) {
+                multiplyKernel()(a, b, c, n, rowBegin, rowEnd);
+            }
+
+            // a + b for the min-plus product. Integer sums below the lowest value clamp to it; sums
+            // above the largest value return false, since they can never be a new minimum.
+            template <typename Weight>
+            bool clampedSum(Weight a, Weight b, Weight& sum) {
+                if (std::numeric_limits<Weight>::is_integer) {
+                    if (b > 0 && a > std::numeric_limits<Weight>::max() - b) {
+                        return false;
+                    }
+                    if (b < 0 && a < std::numeric_limits<Weight>::lowest() - b) {
+                        sum = std::numeric_limits<Weight>::lowest();
+                        return true;
+                    }
+                }
+                sum = static_cast<Weight>(a + b);
+                return true;
+            }
+
+            // Element-wise kernels over count contiguous cells: target = target op source (add,
+            // subtract), target *= scalar (scale) and target += delta (offset)
+            template <typename Weight>
+            void addCellsScalar(Weight* target, const Weight* source, std::size_t count) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    target[i] = static_cast<Weight>(target[i] + source[i]);
+                }
+            }
+
+            template <typename Weight>
+            void subtractCellsScalar(Weight* target, const Weight* source, std::size_t count) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    target[i] = static_cast<Weight>(target[i] - source[i]);
+                }
+            }
+
+            template <typename Weight>
+            void scaleCellsScalar(Weight* target, std::size_t count, Weight scalar) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    target[i] = static_cast<Weight>(target[i] * scalar);
+                }
+            }
+
+            template <typename Weight>
+            void offsetCellsScalar(Weight* target, std::size_t count, Weight delta) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    target[i] = static_cast<Weight>(target[i] + delta);
+                }
+            }
+
+            template <typename Weight>
+            void divideCellsScalar(Weight* target, std::size_t count, const InvariantDivisor<Weight>& divisor) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    target[i] = divisor.divide(target[i]);
+                }
+            }
+
+            template <typename Weight>
+            void divideScalarByCellsScalar(Weight numerator, const Weight* source, Weight* target, std::size_t count) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    target[i] = source[i] == 0 ? 0 : static_cast<Weight>(numerator / source[i]);
+                }
+            }
+
+            // INT_MIN / -1 wraps to INT_MIN here, as it does in the vector kernels
+            void divideScalarByCellsScalar(int numerator, const int* source, int* target, std::size_t count) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    int cell = source[i];
+                    target[i] = cell == 0 ? 0 : (cell == -1 ? static_cast<int>(0U - static_cast<unsigned>(numerator)) : numerator / cell);
+                }
+            }
+
+#ifdef ARIEL_HAS_AVX2_KERNELS
+            // Eight int cells per ymm register; the cells past the last full register go scalar
+            __attribute__((target("avx2")))
+            void addCellsAvx2(int* target, const int* source, std::size_t count) {
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+                    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_add_epi32(t, s));
+                }
+                addCellsScalar(target + i, source + i, count - i);
+            }
+
+            __attribute__((target("avx2")))
+            void subtractCellsAvx2(int* target, const int* source, std::size_t count) {
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+                    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_sub_epi32(t, s));
+                }
+                subtractCellsScalar(target + i, source + i, count - i);
+            }
+
+            __attribute__((target("avx2")))
+            void scaleCellsAvx2(int* target, std::size_t count, int scalar) {
+                __m256i factor = _mm256_set1_epi32(scalar);
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_mullo_epi32(t, factor));
+                }
+                scaleCellsScalar(target + i, count - i, scalar);
+            }
+
+            __attribute__((target("avx2")))
+            void offsetCellsAvx2(int* target, std::size_t count, int delta) {
+                __m256i offset = _mm256_set1_epi32(delta);
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_add_epi32(t, offset));
+                }
+                offsetCellsScalar(target + i, count - i, delta);
+            }
+
+            // Signed multiply-high of eight lanes: the 64-bit products of the even and the odd lanes,
+            // then the magic-number fix-ups of InvariantDivisor<int>::divide
+            __attribute__((target("avx2")))
+            void divideCellsAvx2(int* target, std::size_t count, const InvariantDivisor<int>& divisor) {
+                __m256i multiplier = _mm256_set1_epi32(divisor.getMultiplier());
+                __m256i correction = _mm256_set1_epi32(divisor.getCorrection());
+                __m256i roundUp = _mm256_set1_epi32(divisor.getRoundUp());
+                __m128i shift = _mm_cvtsi32_si128(divisor.getShift());
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+                    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(x, multiplier), 32);
+                    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(x, 32), multiplier);
+                    __m256i q = _mm256_blend_epi32(even, odd, 0xAA);
+                    q = _mm256_add_epi32(q, _mm256_sign_epi32(x, correction));
+                    q = _mm256_sra_epi32(q, shift);
+                    q = _mm256_add_epi32(q, _mm256_and_si256(_mm256_srli_epi32(q, 31), roundUp));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), q);
+                }
+                divideCellsScalar(target + i, count - i, divisor);
+            }
+
+            // Four quotients per step in double precision, which is exact for 32-bit operands;
+            // zero cells divide by one and are masked back to zero
+            __attribute__((target("avx2")))
+            void divideScalarByCellsAvx2(int numerator, const int* source, int* target, std::size_t count) {
+                __m256d top = _mm256_set1_pd(numerator);
+                __m128i zero = _mm_setzero_si128();
+                __m128i one = _mm_set1_epi32(1);
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    __m128i cells = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                    __m128i missing = _mm_cmpeq_epi32(cells, zero);
+                    __m128i divisors = _mm_or_si128(cells, _mm_and_si128(missing, one));
+                    __m128i q = _mm256_cvttpd_epi32(_mm256_div_pd(top, _mm256_cvtepi32_pd(divisors)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), _mm_andnot_si128(missing, q));
+                }
+                divideScalarByCellsScalar(numerator, source + i, target + i, count - i);
+            }
+
+            // Sixteen int cells per zmm register
+            __attribute__((target("avx512f")))
+            void addCellsAvx512(int* target, const int* source, std::size_t count) {
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    __m512i t = _mm512_loadu_si512(target + i);
+                    __m512i s = _mm512_loadu_si512(source + i);
+                    _mm512_storeu_si512(target + i, _mm512_add_epi32(t, s));
+                }
+                addCellsScalar(target + i, source + i, count - i);
+            }
+
+            __attribute__((target("avx512f")))
+            void subtractCellsAvx512(int* target, const int* source, std::size_t count) {
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    __m512i t = _mm512_loadu_si512(target + i);
+                    __m512i s = _mm512_loadu_si512(source + i);
+                    _mm512_storeu_si512(target + i, _mm512_sub_epi32(t, s));
+                }
+                subtractCellsScalar(target + i, source + i, count - i);
+            }
+
+            __attribute__((target("avx512f")))
+            void scaleCellsAvx512(int* target, std::size_t count, int scalar) {
+                __m512i factor = _mm512_set1_epi32(scalar);
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    __m512i t = _mm512_loadu_si512(target + i);
+                    _mm512_storeu_si512(target + i, _mm512_mullo_epi32(t, factor));
+                }
+                scaleCellsScalar(target + i, count - i, scalar);
+            }
+
+            __attribute__((target("avx512f")))
+            void offsetCellsAvx512(int* target, std::size_t count, int delta) {
+                __m512i offset = _mm512_set1_epi32(delta);
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    __m512i t = _mm512_loadu_si512(target + i);
+                    _mm512_storeu_si512(target + i, _mm512_add_epi32(t, offset));
+                }
+                offsetCellsScalar(target + i, count - i, delta);
+            }
+
+            __attribute__((target("avx512f")))
+            void divideCellsAvx512(int* target, std::size_t count, const InvariantDivisor<int>& divisor) {
+                __m512i multiplier = _mm512_set1_epi32(divisor.getMultiplier());
+                __m512i correction = _mm512_set1_epi32(divisor.getCorrection());
+                __m512i roundUp = _mm512_set1_epi32(divisor.getRoundUp());
+                __m128i shift = _mm_cvtsi32_si128(divisor.getShift());
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    __m512i x = _mm512_loadu_si512(target + i);
+                    __m512i even = _mm512_srli_epi64(_mm512_mul_epi32(x, multiplier), 32);
+                    __m512i odd = _mm512_mul_epi32(_mm512_srli_epi64(x, 32), multiplier);
+                    __m512i q = _mm512_mask_blend_epi32(0xAAAA, even, odd);
+                    q = _mm512_add_epi32(q, _mm512_mullo_epi32(x, correction));
+                    q = _mm512_sra_epi32(q, shift);
+                    q = _mm512_add_epi32(q, _mm512_and_si512(_mm512_srli_epi32(q, 31), roundUp));
+                    _mm512_storeu_si512(target + i, q);
+                }
+                divideCellsScalar(target + i, count - i, divisor);
+            }
+
+            __attribute__((target("avx512f")))
+            void divideScalarByCellsAvx512(int numerator, const int* source, int* target, std::size_t count) {
+                __m512d top = _mm512_set1_pd(numerator);
+                __m256i zero = _mm256_setzero_si256();
+                __m256i one = _mm256_set1_epi32(1);
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    __m256i cells = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+                    __m256i missing = _mm256_cmpeq_epi32(cells, zero);
+                    __m256i divisors = _mm256_or_si256(cells, _mm256_and_si256(missing, one));
+                    __m256i q = _mm512_cvttpd_epi32(_mm512_div_pd(top, _mm512_cvtepi32_pd(divisors)));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_andnot_si256(missing, q));
+                }
+                divideScalarByCellsScalar(numerator, source + i, target + i, count - i);
+            }
+#endif
+
+            // The int element-wise kernels of one instruction set
+            struct ElementwiseKernels {
+                const char* name;
+                void (*add)(int*, const int*, std::size_t);
+                void (*subtract)(int*, const int*, std::size_t);
+                void (*scale)(int*, std::size_t, int);
+                void (*offset)(int*, std::size_t, int);
+                void (*divide)(int*, std::size_t, const InvariantDivisor<int>&);
+                void (*divideScalarBy)(int, const int*, int*, std::size_t);
+            };
+
+            ElementwiseKernels selectElementwiseKernels() {
+#ifdef ARIEL_HAS_AVX2_KERNELS
+                if (__builtin_cpu_supports("avx512f")) {
+                    return ElementwiseKernels{"avx512", addCellsAvx512, subtractCellsAvx512, scaleCellsAvx512, offsetCellsAvx512,
+                                              divideCellsAvx512, divideScalarByCellsAvx512};
+                }
+                if (__builtin_cpu_supports("avx2")) {
+                    return ElementwiseKernels{"avx2", addCellsAvx2, subtractCellsAvx2, scaleCellsAvx2, offsetCellsAvx2,
+                                              divideCellsAvx2, divideScalarByCellsAvx2};
+                }
+#endif
+                return ElementwiseKernels{"scalar", addCellsScalar<int>, subtractCellsScalar<int>, scaleCellsScalar<int>, offsetCellsScalar<int>,
+                                          divideCellsScalar<int>, divideScalarByCellsScalar};
+            }
+
+            // Chosen once, on first use
+            const ElementwiseKernels& elementwiseKernels() {
+                static const ElementwiseKernels kernels = selectElementwiseKernels();
+                return kernels;
+            }
+
+            // Non-int weights run the portable loops; int goes through the kernels picked for this CPU
+            template <typename Weight>
+            void addCellsForType(Weight* target, const Weight* source, std::size_t count) {
+                addCellsScalar(target, source, count);
+            }
+
+            void addCellsForType(int* target, const int* source, std::size_t count) {
+                elementwiseKernels().add(target, source, count);
+            }
+
+            template <typename Weight>
+            void subtractCellsForType(Weight* target, const Weight* source, std::size_t count) {
+                subtractCellsScalar(target, source, count);
+            }
+
+            void subtractCellsForType(int* target, const int* source, std::size_t count) {
+                elementwiseKernels().subtract(target, source, count);
+            }
+
+            template <typename Weight>
+            void scaleCellsForType(Weight* target, std::size_t count, Weight scalar) {
+                scaleCellsScalar(target, count, scalar);
+            }
+
+            void scaleCellsForType(int* target, std::size_t count, int scalar) {
+                elementwiseKernels().scale(target, count, scalar);
+            }
+
+            template <typename Weight>
+            void offsetCellsForType(Weight* target, std::size_t count, Weight delta) {
+                offsetCellsScalar(target, count, delta);
+            }
+
+            void offsetCellsForType(int* target, std::size_t count, int delta) {
+                elementwiseKernels().offset(target, count, delta);
+            }
+
+            template <typename Weight>
+            void divideCellsForType(Weight* target, std::size_t count, Weight divisor) {
+                divideCellsScalar(target, count, InvariantDivisor<Weight>(divisor));
+            }
+
+            void divideCellsForType(int* target, std::size_t count, int divisor) {
+                elementwiseKernels().divide(target, count, InvariantDivisor<int>(divisor));
+            }
+
+            template <typename Weight>
+            void divideScalarByCellsForType(Weight numerator, const Weight* source, Weight* target, std::size_t count) {
+                divideScalarByCellsScalar(numerator, source, target, count);
+            }
+
+            void divideScalarByCellsForType(int numerator, const int* source, int* target, std::size_t count) {
+                elementwiseKernels().divideScalarBy(numerator, source, target, count);
+            }
+        }
+
+        /**
+         * @brief Accumulate c += a * b over a band of rows of c with the kernel chosen for this CPU.
+         *
+         * @param a Left operand, n x n row-major.
+         * @param b Right operand, n x n row-major.
+         * @param c Accumulator, n x n row-major; only rows [rowBegin, rowEnd) are written.
+         * @param n Matrix dimension.
+         * @param rowBegin First row of c to compute.
+         * @param rowEnd One past the last row of c to compute.
+         */
+        template <typename Weight>
+        void multiplyAdd(const Weight* a, const Weight* b, Weight* c, std::size_t n, std::size_t rowBegin, std::size_t rowEnd) {
+            multiplyAddForType(a, b, c, n, rowBegin, rowEnd);
+        }
+
+        /**
+         * @brief Min-plus product over a band of rows of c, tiled i-k-j like multiplyAdd.
+         *
+         * @param a Left operand, n x n row-major.
+         * @param b Right operand, n x n row-major.
+         * @param c Running minimum, n x n row-major; only rows [rowBegin, rowEnd) are written.
+         * @param n Matrix dimension.
+         * @param rowBegin First row of c to compute.
+         * @param rowEnd One past the last row of c to compute.
+         * @param infinity The cell value that marks a missing entry.
+         */
+        template <typename Weight>
+        void minPlus(const Weight* a, const Weight* b, Weight* c, std::size_t n, std::size_t rowBegin, std::size_t rowEnd, Weight infinity) {
+            for (std::size_t ii = rowBegin; ii < rowEnd; ii += TILE) {
+                std::size_t iEnd = std::min(ii + TILE, rowEnd);
+                for (std::size_t kk = 0; kk < n; kk += TILE) {
+                    std::size_t kEnd = std::min(kk + TILE, n);
+                    for (std::size_t jj = 0; jj < n; jj += TILE) {
+                        std::size_t jEnd = std::min(jj + TILE, n);
+                        for (std::size_t i = ii; i < iEnd; ++i) {
+                            Weight* cRow = c + i * n;
+                            for (std::size_t k = kk; k < kEnd; ++k) {
+                                Weight aik = a[i * n + k];
+                                if (aik == infinity) {
+                                    continue;
+                                }
+                                const Weight* bRow = b + k * n;
+                                for (std::size_t j = jj; j < jEnd; ++j) {
+                                    Weight sum;
+                                    if (bRow[j] != infinity && clampedSum(aik, bRow[j], sum) && sum < cRow[j]) {
+                                        cRow[j] = sum;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Add source into target cell by cell with the kernel chosen for this CPU.
+         *
+         * @param target Cells to update.
+         * @param source Cells to add; may not partially overlap target.
+         * @param count Number of cells.
+         */
+        template <typename Weight>
+        void addCells(Weight* target, const Weight* source, std::size_t count) {
+            addCellsForType(target, source, count);
+        }
+
+        /**
+         * @brief Subtract source from target cell by cell with the kernel chosen for this CPU.
+         *
+         * @param target Cells to update.
+         * @param source Cells to subtract; may not partially overlap target.
+         * @param count Number of cells.
+         */
+        template <typename Weight>
+        void subtractCells(Weight* target, const Weight* source, std::size_t count) {
+            subtractCellsForType(target, source, count);
+        }
+
+        /**
+         * @brief Multiply every cell of target by scalar with the kernel chosen for this CPU.
+         *
+         * @param target Cells to update.
+         * @param count Number of cells.
+         * @param scalar The factor.
+         */
+        template <typename Weight>
+        void scaleCells(Weight* target, std::size_t count, Weight scalar) {
+            scaleCellsForType(target, count, scalar);
+        }
+
+        /**
+         * @brief Add delta to every cell of target with the kernel chosen for this CPU.
+         *
+         * @param target Cells to update.
+         * @param count Number of cells.
+         * @param delta The amount to add.
+         */
+        template <typename Weight>
+        void offsetCells(Weight* target, std::size_t count, Weight delta) {
+            offsetCellsForType(target, count, delta);
+        }
+
+        /**
+         * @brief Divide every cell of target by one divisor with the kernel chosen for this CPU.
+         *
+         * @param target Cells to update.
+         * @param count Number of cells.
+         * @param divisor The divisor; must not be zero.
+         */
+        template <typename Weight>
+        void divideCells(Weight* target, std::size_t count, Weight divisor) {
+            divideCellsForType(target, count, divisor);
+        }
+
+        /**
+         * @brief Divide numerator by every non-zero cell of source with the kernel chosen for this CPU.
+         *
+         * @param numerator The dividend of every quotient.
+         * @param source Divisor cells; zero cells yield zero.
+         * @param target Quotients; may be source itself.
+         * @param count Number of cells.
+         */
+        template <typename Weight>
+        void divideScalarByCells(Weight numerator, const Weight* source, Weight* target, std::size_t count) {
+            divideScalarByCellsForType(numerator, source, target, count);
+        }
+
+        /**
+         * @brief Name of the multiplication kernel selected at runtime.
+         *
+         * @return const char* "avx2" or "scalar".
+         */
+        const char* multiplyKernelName() {
+#ifdef ARIEL_HAS_AVX2_KERNELS
+            if (multiplyKernel() == multiplyAddAvx2) {
+                return "avx2";
+            }
+#endif
+            return "scalar";
+        }
+
+        /**
+         * @brief Name of the element-wise kernels selected at runtime.
+         *
+         * @return const char* "avx512", "avx2" or "scalar".
+         */
+        const char* elementwiseKernelName() {
+            return elementwiseKernels().name;
+        }
+
+#define ARIEL_INSTANTIATE_KERNELS(Weight)                                                                                            \
+        template void multiplyAdd(const Weight*, const Weight*, Weight*, std::size_t, std::size_t, std::size_t);                     \
+        template void minPlus(const Weight*, const Weight*, Weight*, std::size_t, std::size_t, std::size_t, Weight);                 \
+        template void addCells(Weight*, const Weight*, std::size_t);                                                                 \
+        template void subtractCells(Weight*, const Weight*, std::size_t);                                                            \
+        template void scaleCells(Weight*, std::size_t, Weight);                                                                      \
+        template void offsetCells(Weight*, std::size_t, Weight);                                                                     \
+        template void divideCells(Weight*, std::size_t, Weight);                                                                     \
+        template void divideScalarByCells(Weight, const Weight*, Weight*, std::size_t);
+
+        ARIEL_FOR_EACH_WEIGHT(ARIEL_INSTANTIATE_KERNELS)
+
+    } // namespace kernels
+} // namespace ariel
\ No newline at end of file
@@ -0,0 +1,128 @@
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ariel {
+    namespace kernels {
+
+        // Accumulate c += a * b over rows [rowBegin, rowEnd) of c, for n x n row-major matrices.
+        // int matrices use an AVX2 kernel when the CPU supports it; everything else runs a tiled scalar kernel.
+        template <typename Weight>
+        void multiplyAdd(const Weight* a, const Weight* b, Weight* c, std::size_t n, std::size_t rowBegin, std::size_t rowEnd);
+
+        // Min-plus (tropical) product over rows [rowBegin, rowEnd) of c: c[i][j] = min(c[i][j], a[i][k] + b[k][j]).
+        // Cells equal to infinity are absent and never take part in a sum; integer sums saturate at the lowest value.
+        template <typename Weight>
+        void minPlus(const Weight* a, const Weight* b, Weight* c, std::size_t n, std::size_t rowBegin, std::size_t rowEnd, Weight infinity);
+
+        // Element-wise updates of count contiguous cells: target += source, target -= source,
+        // target *= scalar and target += delta. int cells use AVX-512 or AVX2 when the CPU supports it.
+        template <typename Weight>
+        void addCells(Weight* target, const Weight* source, std::size_t count);
+        template <typename Weight>
+        void subtractCells(Weight* target, const Weight* source, std::size_t count);
+        template <typename Weight>
+        void scaleCells(Weight* target, std::size_t count, Weight scalar);
+        template <typename Weight>
+        void offsetCells(Weight* target, std::size_t count, Weight delta);
+
+        // Quotients by one divisor that is reused for many dividends; the divisor must not be zero
+        template <typename Weight>
+        class InvariantDivisor {
+        private:
+            Weight divisor;
+
+        public:
+            explicit InvariantDivisor(Weight divisor) : divisor(divisor) {}
+
+            Weight divide(Weight dividend) const { return static_cast<Weight>(dividend / divisor); }
+        };
+
+        // int quotients without idiv: the divisor is turned once into a magic multiplier and shift
+        // (Granlund-Montgomery, as in libdivide), and each quotient costs a multiply-high, an add
+        // and two shifts. Rounds toward zero like /; INT_MIN / -1 wraps to INT_MIN.
+        template <>
+        class InvariantDivisor<int> {
+        private:
+            int multiplier;
+            int shift;
+            int correction; // The dividend is added (1), subtracted (-1) or ignored (0) after the multiply-high
+            int roundUp;    // 1 to round negative quotients up toward zero; 0 for divisors of +-1
+
+        public:
+            explicit InvariantDivisor(int divisor) : multiplier(0), shift(0), correction(divisor), roundUp(0) {
+                if (divisor == 1 || divisor == -1) {
+                    return; // The quotient is just the dividend times the correction
+                }
+                // Smallest p >= 32 with a multiplier of 2^p / |divisor| rounded up that is exact for
+                // every 32-bit dividend (Hacker's Delight, section 10-4)
+                const std::uint32_t two31 = 0x80000000U;
+                std::uint32_t absolute = divisor < 0 ? 0U - static_cast<std::uint32_t>(divisor) : static_cast<std::uint32_t>(divisor);
+                std::uint32_t t = two31 + (static_cast<std::uint32_t>(divisor) >> 31);
+                std::uint32_t absoluteNc = t - 1 - t % absolute;
+                int p = 31;
+                std::uint32_t q1 = two31 / absoluteNc;
+                std::uint32_t r1 = two31 - q1 * absoluteNc;
+                std::uint32_t q2 = two31 / absolute;
+                std::uint32_t r2 = two31 - q2 * absolute;
+                std::uint32_t delta;
+                do {
+                    ++p;
+                    q1 *= 2;
+                    r1 *= 2;
+                    if (r1 >= absoluteNc) {
+                        ++q1;
+                        r1 -= absoluteNc;
+                    }
+                    q2 *= 2;
+                    r2 *= 2;
+                    if (r2 >= absolute) {
+                        ++q2;
+                        r2 -= absolute;
+                    }
+                    delta = absolute - r2;
+                } while (q1 < delta || (q1 == delta && r1 == 0));
+
+                std::uint32_t magic = q2 + 1;
+                multiplier = static_cast<int>(divisor < 0 ? 0U - magic : magic);
+                shift = p - 32;
+                correction = divisor > 0 && multiplier < 0 ? 1 : (divisor < 0 && multiplier > 0 ? -1 : 0);
+                roundUp = 1;
+            }
+
+            int getMultiplier() const { return multiplier; }
+            int getShift() const { return shift; }
+            int getCorrection() const { return correction; }
+            int getRoundUp() const { return roundUp; }
+
+            int divide(int dividend) const {
+                std::int64_t product = static_cast<std::int64_t>(multiplier) * dividend;
+                // Unsigned arithmetic wraps where the signed sum could overflow
+                std::uint32_t sum = static_cast<std::uint32_t>(product >> 32) + static_cast<std::uint32_t>(dividend) * static_cast<std::uint32_t>(correction);
+                int quotient = static_cast<int>(sum) >> shift;
+                return quotient + (static_cast<int>(static_cast<std::uint32_t>(quotient) >> 31) & roundUp);
+            }
+        };
+
+        // target /= divisor, cell by cell; int cells use AVX-512 or AVX2 when the CPU supports it.
+        // divisor must not be zero.
+        template <typename Weight>
+        void divideCells(Weight* target, std::size_t count, Weight divisor);
+
+        // target = numerator / source for every non-zero source cell, 0 elsewhere. int cells divide
+        // as doubles (exact for 32-bit operands) with AVX-512 or AVX2 when the CPU supports it.
+        template <typename Weight>
+        void divideScalarByCells(Weight numerator, const Weight* source, Weight* target, std::size_t count);
+
+        // Name of the int multiplication kernel selected for this CPU ("avx2" or "scalar")
+        const char* multiplyKernelName();
+
+        // Name of the int element-wise kernels selected for this CPU ("avx512", "avx2" or "scalar")
+        const char* elementwiseKernelName();
+
+    } // namespace kernels
+} // namespace ariel
+
+#endif // KERNELS_HPP
\ No newline at end of file
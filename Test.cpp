@@ -1,6 +1,9 @@
 #include "doctest.h"
 #include "Algorithms.hpp"
 #include "Graph.hpp"
+#include "Kernels.hpp"
+#include "ThreadPool.hpp"
+#include <sstream>
 
 using namespace std;
 
@@ -837,4 +840,1260 @@ TEST_CASE("Test graph multiplication with empty matrices")
     ariel::Graph emptyGraph2;
     ariel::Graph result = emptyGraph1 * emptyGraph2;
     CHECK(result.printGraph() == emptyGraph1.printGraph());
+}
+
+TEST_CASE("Test adjacency matrix view")
+{
+    ariel::Graph g1;
+    vector<vector<int>> graph = {
+            {0, 1, 2},
+            {3, 0, 4}};
+    g1.loadGraph(graph);
+    ariel::MatrixView view = g1.getAdjacencyMatrix();
+    CHECK(view.size() == 2);
+    CHECK(view[0].size() == 3);
+    CHECK(view[1][2] == 4);
+    CHECK(view.data()[3] == 3);
+    vector<vector<int>> nested = view;
+    CHECK(nested == graph);
+
+    // Reloading with different dimensions must not keep stale cells
+    vector<vector<int>> graph2 = {
+            {0, 5},
+            {6, 0},
+            {7, 8}};
+    g1.loadGraph(graph2);
+    CHECK(g1.getRows() == 3);
+    CHECK(g1.getCols() == 2);
+    CHECK(g1.printGraph() == "[0, 5]\n[6, 0]\n[7, 8]");
+
+    ariel::Graph g2 = g1;
+    g2.setAdjacencyMatrix(2, 1, 9);
+    CHECK(g1.getAdjacencyMatrix()[2][1] == 8);
+    CHECK(g2.getAdjacencyMatrix()[2][1] == 9);
+    CHECK_THROWS(g2.setAdjacencyMatrix(1, 2, 1));
+}
+
+TEST_CASE("Test sparse representation")
+{
+    vector<vector<int>> graph = {
+            {0, 1, 0, 0, 0},
+            {1, 0, 3, 0, 0},
+            {0, 3, 0, 0, 0},
+            {0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0}};
+    ariel::Graph sparse;
+    sparse.loadGraph(graph);
+    CHECK_FALSE(sparse.isSparse()); // 4 of 25 cells are edges, too dense for Auto to pick CSR
+    sparse.loadGraph(graph, ariel::Representation::Sparse);
+    CHECK(sparse.isSparse());
+    const ariel::SparseAdjacency& csr = sparse.getSparseAdjacency();
+    CHECK(csr.offsets == vector<size_t>{0, 1, 3, 4, 4, 4});
+    CHECK(csr.neighbors == vector<size_t>{1, 0, 2, 1});
+    CHECK(csr.weights == vector<int>{1, 1, 3, 3});
+
+    ariel::Graph dense;
+    dense.loadGraph(graph, ariel::Representation::Dense);
+    CHECK_FALSE(dense.isSparse());
+    CHECK(dense.getSparseAdjacency().neighbors.empty());
+
+    ariel::Graph ring(10, 10);
+    ring.setAdjacencyMatrix(0, 9, 1);
+    ring.setAdjacencyMatrix(9, 0, 1);
+    ring.setRepresentation(ariel::Representation::Auto);
+    CHECK(ring.isSparse());
+
+    // Both representations must give the same answers
+    CHECK(ariel::Algorithms::isConnected(sparse) == ariel::Algorithms::isConnected(dense));
+    CHECK(ariel::Algorithms::shortestPath(sparse, 0, 2) == ariel::Algorithms::shortestPath(dense, 0, 2));
+    CHECK(ariel::Algorithms::isBipartite(sparse) == ariel::Algorithms::isBipartite(dense));
+    CHECK(ariel::Algorithms::isContainsCycle(sparse) == ariel::Algorithms::isContainsCycle(dense));
+
+    // Single-cell updates keep the CSR index in sync
+    sparse.setAdjacencyMatrix(2, 3, 5);
+    sparse.setAdjacencyMatrix(3, 2, 5);
+    sparse.setAdjacencyMatrix(1, 0, 0);
+    sparse.setAdjacencyMatrix(0, 1, 7);
+    CHECK(csr.offsets == vector<size_t>{0, 1, 2, 4, 5, 5});
+    CHECK(csr.neighbors == vector<size_t>{1, 2, 1, 3, 2});
+    CHECK(csr.weights == vector<int>{7, 3, 3, 5, 5});
+    CHECK(ariel::Algorithms::shortestPath(sparse, 0, 3) == "0->1->2->3");
+
+    // Whole-graph operators rebuild the index
+    sparse *= 2;
+    CHECK(csr.weights == vector<int>{14, 6, 6, 10, 10});
+    sparse.setRepresentation(ariel::Representation::Dense);
+    CHECK(csr.offsets.empty());
+}
+
+TEST_CASE("Test shortest path with Dijkstra")
+{
+    ariel::Graph g1;
+    vector<vector<int>> graph = {
+            {0, 4, 1, 0, 0},
+            {4, 0, 2, 5, 0},
+            {1, 2, 0, 8, 0},
+            {0, 5, 8, 0, 3},
+            {0, 0, 0, 3, 0}};
+    g1.loadGraph(graph);
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 4) == "0->2->1->3->4");
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 4, ariel::ShortestPathMode::Dijkstra) == "0->2->1->3->4");
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 4, ariel::ShortestPathMode::BellmanFord) == "0->2->1->3->4");
+    CHECK(ariel::Algorithms::shortestPath(g1, 3, 3) == "3");
+
+    // Unreachable destination
+    g1.setAdjacencyMatrix(3, 4, 0);
+    g1.setAdjacencyMatrix(4, 3, 0);
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 4) == "-1");
+
+    // A negative edge makes Auto fall back to Bellman-Ford
+    ariel::Graph g2;
+    vector<vector<int>> directed = {
+            {0, 4, 1},
+            {0, 0, 0},
+            {0, -3, 0}};
+    g2.loadGraph(directed);
+    CHECK(ariel::Algorithms::shortestPath(g2, 0, 1) == "0->2->1");
+}
+
+TEST_CASE("Test negative weights with SPFA and Bellman-Ford")
+{
+    ariel::Graph g1;
+    vector<vector<int>> graph = {
+            {0, 6, 7, 0},
+            {0, 0, 8, 5},
+            {0, 0, 0, -3},
+            {0, -2, 0, 0}};
+    g1.loadGraph(graph);
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 1) == "0->2->3->1");
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 1, ariel::ShortestPathMode::Spfa) == "0->2->3->1");
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 1, ariel::ShortestPathMode::BellmanFord) == "0->2->3->1");
+    CHECK(ariel::Algorithms::negativeCycle(g1) == "The graph does not contain a negative cycle.");
+
+    // 1->2->3->1 now weighs 8 - 3 - 6 = -1
+    g1.setAdjacencyMatrix(3, 1, -6);
+    CHECK(ariel::Algorithms::negativeCycle(g1) == "The graph contains a negative cycle.");
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 3, ariel::ShortestPathMode::Spfa) == "-1");
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 3, ariel::ShortestPathMode::BellmanFord) == "-1");
+
+    // The cycle 1->2->1 is reachable from 0 but cannot reach 3, so 0->3 keeps its shortest path
+    ariel::Graph g2;
+    g2.loadGraph({
+            {0, 1, 0, 5},
+            {0, 0, -2, 0},
+            {0, 1, 0, 0},
+            {0, 0, 0, 0}});
+    CHECK(ariel::Algorithms::floydWarshall(g2).path(0, 3) == "0->3");
+    for (ariel::ShortestPathMode mode : {ariel::ShortestPathMode::Auto, ariel::ShortestPathMode::BellmanFord, ariel::ShortestPathMode::Spfa}) {
+        CHECK(ariel::Algorithms::shortestPath(g2, 0, 3, mode) == "0->3");
+        CHECK(ariel::Algorithms::shortestPath(g2, 0, 2, mode) == "-1");
+    }
+    vector<string> batch = ariel::Algorithms::shortestPaths(g2, {{0, 3}, {0, 1}, {3, 3}});
+    CHECK(batch == vector<string>{"0->3", "-1", "3"});
+}
+
+TEST_CASE("Test iterative DFS on a long path")
+{
+    const size_t length = 2000;
+    vector<vector<int>> path(length, vector<int>(length, 0));
+    for (size_t i = 0; i + 1 < length; ++i) {
+        path[i][i + 1] = 1;
+        path[i + 1][i] = 1;
+    }
+    ariel::Graph g1;
+    g1.loadGraph(path);
+    CHECK(ariel::Algorithms::isConnected(g1));
+    CHECK(ariel::Algorithms::isContainsCycle(g1) == "-1");
+
+    g1.setAdjacencyMatrix(length - 1, 0, 1);
+    g1.setAdjacencyMatrix(0, length - 1, 1);
+    CHECK(ariel::Algorithms::isContainsCycle(g1) != "-1");
+
+    ariel::Graph g2;
+    vector<vector<int>> graph = {
+            {0, 1, 0, 0},
+            {1, 0, 1, 1},
+            {0, 1, 0, 1},
+            {0, 1, 1, 0}};
+    g2.loadGraph(graph);
+    CHECK(ariel::Algorithms::isContainsCycle(g2) == "1->2->3->1");
+    g2.setAdjacencyMatrix(2, 1, 0);
+    g2.setAdjacencyMatrix(1, 2, 0);
+    g2.setAdjacencyMatrix(2, 3, 0);
+    g2.setAdjacencyMatrix(3, 2, 0);
+    CHECK_FALSE(ariel::Algorithms::isConnected(g2));
+
+    // A caller-owned scratch is allocated by the first query and reused by the next ones
+    vector<vector<int>> shortPath(length / 4, vector<int>(length / 4, 0));
+    for (size_t i = 0; i + 1 < shortPath.size(); ++i) {
+        shortPath[i][i + 1] = 1;
+        shortPath[i + 1][i] = 1;
+    }
+    ariel::Graph g3;
+    g3.loadGraph(shortPath, ariel::Representation::Sparse);
+    ariel::TraversalScratch scratch;
+    CHECK(ariel::Algorithms::isConnected(g3, scratch));
+    const pair<size_t, size_t>* frames = scratch.stack.data();
+    CHECK(scratch.stack.capacity() >= shortPath.size());
+    CHECK(ariel::Algorithms::isContainsCycle(g3, scratch) == "-1");
+    CHECK(ariel::Algorithms::isConnected(g3, scratch));
+    CHECK(scratch.stack.data() == frames);
+    g3.setAdjacencyMatrix(0, 2, 1);
+    g3.setAdjacencyMatrix(2, 0, 1);
+    CHECK(ariel::Algorithms::isContainsCycle(g3, scratch) == ariel::Algorithms::isContainsCycle(g3));
+    CHECK(ariel::Algorithms::findCycle(g3, scratch, ariel::GraphKind::Directed).found);
+}
+
+TEST_CASE("Test bit-parallel connectivity and bipartiteness")
+{
+    // An even cycle over 130 vertices spans three 64-bit words per row
+    const size_t size = 130;
+    vector<vector<int>> cycle(size, vector<int>(size, 0));
+    for (size_t i = 0; i < size; ++i) {
+        cycle[i][(i + 1) % size] = 1;
+        cycle[(i + 1) % size][i] = 1;
+    }
+    ariel::Graph dense;
+    dense.loadGraph(cycle, ariel::Representation::Dense);
+    ariel::Graph sparse;
+    sparse.loadGraph(cycle, ariel::Representation::Sparse);
+
+    ariel::BitMatrix bits = dense.getBitMatrix();
+    CHECK(bits.getWordsPerRow() == 3);
+    CHECK(bits.test(129, 0));
+    CHECK_FALSE(bits.test(129, 1));
+
+    CHECK(ariel::Algorithms::isConnected(dense));
+    CHECK(ariel::Algorithms::isBipartite(dense) == ariel::Algorithms::isBipartite(sparse));
+
+    // A chord between two even vertices creates an odd cycle
+    dense.setAdjacencyMatrix(0, 64, 1);
+    dense.setAdjacencyMatrix(64, 0, 1);
+    CHECK(ariel::Algorithms::isBipartite(dense) == "0");
+
+    // Cutting the cycle twice splits it into two components
+    dense.setAdjacencyMatrix(10, 11, 0);
+    dense.setAdjacencyMatrix(11, 10, 0);
+    dense.setAdjacencyMatrix(100, 101, 0);
+    dense.setAdjacencyMatrix(101, 100, 0);
+    dense.setAdjacencyMatrix(0, 64, 0);
+    dense.setAdjacencyMatrix(64, 0, 0);
+    CHECK_FALSE(ariel::Algorithms::isConnected(dense));
+
+    // The bit matrix is kept current by every write instead of being rebuilt per query
+    CHECK_FALSE(dense.getBitMatrix().test(10, 11));
+    CHECK(dense.getBitMatrix().test(11, 12));
+    ariel::Graph doubled = dense + dense;
+    CHECK(doubled.getBitMatrix().test(11, 12));
+    doubled -= doubled;
+    CHECK_FALSE(doubled.getBitMatrix().test(11, 12));
+    CHECK(sparse.getBitMatrix().size() == 0);
+    sparse.setRepresentation(ariel::Representation::Dense);
+    CHECK(sparse.getBitMatrix().test(129, 0));
+
+    ariel::Graph g1;
+    vector<vector<int>> graph = {
+            {0, 1, 0, 0},
+            {1, 0, 1, 0},
+            {0, 1, 0, 0},
+            {0, 0, 0, 0}};
+    g1.loadGraph(graph, ariel::Representation::Dense);
+    CHECK(ariel::Algorithms::isBipartite(g1) == "The graph is bipartite: A={0, 2, 3}, B={1}.");
+}
+
+TEST_CASE("Test graph multiplication against the naive product")
+{
+    // 70 is not a multiple of the tile or vector widths, so every edge case of the kernel runs
+    const size_t size = 70;
+    vector<vector<int>> left(size, vector<int>(size, 0));
+    vector<vector<int>> right(size, vector<int>(size, 0));
+    for (size_t i = 0; i < size; ++i) {
+        for (size_t j = 0; j < size; ++j) {
+            left[i][j] = static_cast<int>((i * 7 + j * 3) % 11) - 5;
+            right[i][j] = static_cast<int>((i * 5 + j * 13) % 9) - 4;
+        }
+    }
+    ariel::Graph g1;
+    g1.loadGraph(left);
+    ariel::Graph g2;
+    g2.loadGraph(right);
+
+    ariel::Graph product = g1 * g2;
+    ariel::MatrixView view = product.getAdjacencyMatrix();
+    bool matches = true;
+    for (size_t i = 0; i < size; ++i) {
+        for (size_t j = 0; j < size; ++j) {
+            int expected = 0;
+            for (size_t k = 0; k < size; ++k) {
+                expected += left[i][k] * right[k][j];
+            }
+            if (i == j) {
+                expected = 0;
+            }
+            matches = matches && view[i][j] == expected;
+        }
+    }
+    CHECK(matches);
+    CHECK(product.getRows() == 70);
+    CHECK(product.getCols() == 70);
+}
+
+TEST_CASE("Test parallel graph multiplication")
+{
+    const size_t size = 150;
+    vector<vector<int>> data(size, vector<int>(size, 0));
+    for (size_t i = 0; i < size; ++i) {
+        for (size_t j = 0; j < size; ++j) {
+            data[i][j] = static_cast<int>((i * 17 + j * 29) % 7) - 3;
+        }
+    }
+    ariel::Graph g1;
+    g1.loadGraph(data);
+
+    ariel::ThreadPool::setSharedThreadCount(1);
+    ariel::Graph serial = g1 * g1;
+    ariel::ThreadPool::setSharedThreadCount(4);
+    CHECK(ariel::ThreadPool::getSharedThreadCount() == 4);
+    ariel::Graph parallel = g1 * g1;
+    CHECK(parallel == serial);
+
+    g1 *= g1;
+    CHECK(g1 == serial);
+    ariel::ThreadPool::setSharedThreadCount(0);
+
+    // Every index is visited exactly once and chunk failures reach the caller
+    ariel::ThreadPool pool(3);
+    vector<int> hits(1000, 0);
+    pool.parallelFor(0, hits.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ++hits[i];
+        }
+    });
+    bool allOnce = true;
+    for (int hit : hits) {
+        allOnce = allOnce && hit == 1;
+    }
+    CHECK(allOnce);
+    CHECK_THROWS_AS(pool.parallelFor(0, 10, [](size_t begin, size_t) {
+        if (begin == 0) {
+            throw std::runtime_error("chunk failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST_CASE("Test all-pairs shortest paths by min-plus squaring")
+{
+    const int inf = ariel::Graph::INFINITE_DISTANCE;
+    ariel::Graph g1;
+    vector<vector<int>> graph = {
+            {0, 3, 8, 0, -4},
+            {0, 0, 0, 1, 7},
+            {0, 4, 0, 0, 0},
+            {2, 0, -5, 0, 0},
+            {0, 0, 0, 6, 0}};
+    g1.loadGraph(graph);
+    ariel::Graph distances = ariel::Algorithms::allPairsShortestPaths(g1);
+    CHECK(distances.printGraph() == "[0, 1, -3, 2, -4]\n[3, 0, -4, 1, -1]\n[7, 4, 0, 5, 3]\n[2, -1, -5, 0, -2]\n[8, 5, 1, 6, 0]");
+
+    // Unreachable pairs stay infinite
+    ariel::Graph g2;
+    vector<vector<int>> directed = {
+            {0, 2, 0},
+            {0, 0, 3},
+            {0, 0, 0}};
+    g2.loadGraph(directed);
+    ariel::Graph reach = ariel::Algorithms::allPairsShortestPaths(g2);
+    ariel::MatrixView view = reach.getAdjacencyMatrix();
+    CHECK(view[0][2] == 5);
+    CHECK(view[2][0] == inf);
+    CHECK(view[1][0] == inf);
+
+    // Zero is a real length in a distance matrix, infinity is a missing entry
+    ariel::Graph d1;
+    d1.loadGraph({{0, inf}, {1, 0}});
+    CHECK(d1.minPlus(d1).printGraph() == "[0, " + to_string(inf) + "]\n[1, 0]");
+
+    g2.setAdjacencyMatrix(2, 0, -6);
+    CHECK_THROWS(ariel::Algorithms::allPairsShortestPaths(g2));
+}
+
+TEST_CASE("Test blocked Floyd-Warshall")
+{
+    ariel::Graph g1;
+    vector<vector<int>> graph = {
+            {0, 3, 8, 0, -4},
+            {0, 0, 0, 1, 7},
+            {0, 4, 0, 0, 0},
+            {2, 0, -5, 0, 0},
+            {0, 0, 0, 6, 0}};
+    g1.loadGraph(graph);
+    ariel::ShortestPathTable table = ariel::Algorithms::floydWarshall(g1);
+    CHECK_FALSE(table.hasNegativeCycle());
+    CHECK(table.distance(0, 2) == -3);
+    CHECK(table.path(0, 2) == "0->4->3->2");
+    CHECK(table.path(2, 0) == "2->1->3->0");
+    CHECK(table.path(1, 1) == "1");
+
+    // 150 vertices span several blocks; every path must add up to its distance
+    const size_t size = 150;
+    vector<vector<int>> ring(size, vector<int>(size, 0));
+    for (size_t i = 0; i < size; ++i) {
+        ring[i][(i + 1) % size] = static_cast<int>(i % 5) + 1;
+        ring[i][(i * 7 + 3) % size] = static_cast<int>(i % 11) + 2;
+    }
+    ariel::Graph g2;
+    g2.loadGraph(ring);
+    ariel::ShortestPathTable large = ariel::Algorithms::floydWarshall(g2);
+    ariel::Graph squared = ariel::Algorithms::allPairsShortestPaths(g2);
+    ariel::MatrixView expected = squared.getAdjacencyMatrix();
+    bool distancesMatch = true;
+    bool pathsMatch = true;
+    for (size_t from = 0; from < size; from += 7) {
+        for (size_t to = 0; to < size; ++to) {
+            distancesMatch = distancesMatch && large.distance(from, to) == expected[from][to];
+            string path = large.path(from, to);
+            int length = 0;
+            size_t previous = from;
+            size_t position = path.find("->");
+            while (position != string::npos) {
+                size_t next = stoul(path.substr(position + 2));
+                length += ring[previous][next];
+                previous = next;
+                position = path.find("->", position + 2);
+            }
+            pathsMatch = pathsMatch && previous == to && length == large.distance(from, to);
+        }
+    }
+    CHECK(distancesMatch);
+    CHECK(pathsMatch);
+
+    g1.setAdjacencyMatrix(2, 1, -4);
+    ariel::ShortestPathTable negative = ariel::Algorithms::floydWarshall(g1);
+    CHECK(negative.hasNegativeCycle());
+    CHECK(negative.path(0, 2) == "-1");
+}
+
+TEST_CASE("Test structured algorithm results")
+{
+    ariel::Graph g1;
+    vector<vector<int>> graph = {
+            {0, 1, 0, 0},
+            {1, 0, 1, 1},
+            {0, 1, 0, 1},
+            {0, 1, 1, 0}};
+    g1.loadGraph(graph);
+
+    ariel::PathResult path = ariel::Algorithms::findShortestPath(g1, 0, 3);
+    CHECK(path.found);
+    CHECK(path.vertices == vector<size_t>{0, 1, 3});
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 3) == "0->1->3");
+
+    ariel::PathResult cycle = ariel::Algorithms::findCycle(g1);
+    CHECK(cycle.found);
+    CHECK(cycle.vertices == vector<size_t>{1, 2, 3, 1});
+    CHECK(ariel::Algorithms::isContainsCycle(g1) == "1->2->3->1");
+
+    ariel::BipartiteResult odd = ariel::Algorithms::findBipartition(g1);
+    CHECK_FALSE(odd.bipartite);
+    CHECK(ariel::Algorithms::isBipartite(g1) == "0");
+
+    g1.setAdjacencyMatrix(2, 3, 0);
+    g1.setAdjacencyMatrix(3, 2, 0);
+    ariel::BipartiteResult tree = ariel::Algorithms::findBipartition(g1);
+    CHECK(tree.bipartite);
+    CHECK(tree.sideA == vector<size_t>{0, 2, 3});
+    CHECK(tree.sideB == vector<size_t>{1});
+    CHECK_FALSE(ariel::Algorithms::findCycle(g1).found);
+    CHECK_FALSE(ariel::Algorithms::hasNegativeCycle(g1));
+
+    g1.setAdjacencyMatrix(0, 1, 0);
+    CHECK_FALSE(ariel::Algorithms::findShortestPath(g1, 0, 3).found);
+    CHECK(ariel::Algorithms::floydWarshall(g1).route(1, 0).vertices == vector<size_t>{1, 0});
+}
+
+TEST_CASE("Test batch shortest paths")
+{
+    ariel::Graph g1;
+    vector<vector<int>> graph = {
+            {0, 4, 1, 0, 0},
+            {4, 0, 2, 5, 0},
+            {1, 2, 0, 8, 0},
+            {0, 5, 8, 0, 3},
+            {0, 0, 0, 3, 0}};
+    g1.loadGraph(graph);
+
+    vector<pair<size_t, size_t>> queries;
+    for (size_t start = 0; start < 5; ++start) {
+        for (size_t end = 0; end < 5; ++end) {
+            queries.push_back(make_pair(4 - start, end));
+        }
+    }
+    ariel::ThreadPool::setSharedThreadCount(3);
+    vector<string> paths = ariel::Algorithms::shortestPaths(g1, queries);
+    ariel::ThreadPool::setSharedThreadCount(0);
+    REQUIRE(paths.size() == queries.size());
+    bool matches = true;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        matches = matches && paths[i] == ariel::Algorithms::shortestPath(g1, queries[i].first, queries[i].second);
+    }
+    CHECK(matches);
+    CHECK(paths[0] == "4->3->1->2->0");
+
+    // Negative weights go through SPFA, unreachable targets report "-1"
+    ariel::Graph g2;
+    vector<vector<int>> directed = {
+            {0, 4, 1},
+            {0, 0, 0},
+            {0, -3, 0}};
+    g2.loadGraph(directed);
+    vector<ariel::PathResult> results = ariel::Algorithms::findShortestPaths(g2, {{0, 1}, {1, 0}, {0, 2}});
+    CHECK(results[0].vertices == vector<size_t>{0, 2, 1});
+    CHECK_FALSE(results[1].found);
+    CHECK(results[2].vertices == vector<size_t>{0, 2});
+    CHECK(ariel::Algorithms::findShortestPaths(g2, {}).empty());
+}
+
+TEST_CASE("Test bidirectional Dijkstra and A*")
+{
+    // Directed ring with chords, so forward and backward searches walk different edges
+    const size_t size = 60;
+    vector<vector<int>> ring(size, vector<int>(size, 0));
+    for (size_t i = 0; i < size; ++i) {
+        ring[i][(i + 1) % size] = static_cast<int>(i % 5) + 1;
+        ring[i][(i * 7 + 3) % size] = static_cast<int>(i % 11) + 2;
+    }
+    ariel::Graph dense;
+    dense.loadGraph(ring, ariel::Representation::Dense);
+    ariel::Graph sparse;
+    sparse.loadGraph(ring, ariel::Representation::Sparse);
+
+    bool matches = true;
+    for (size_t start = 0; start < size; start += 7) {
+        for (size_t end = 0; end < size; ++end) {
+            ariel::PathResult expected = ariel::Algorithms::findShortestPath(dense, start, end, ariel::ShortestPathMode::Dijkstra);
+            for (const ariel::Graph* graph : {&dense, &sparse}) {
+                ariel::PathResult result = ariel::Algorithms::findShortestPath(*graph, start, end, ariel::ShortestPathMode::BidirectionalDijkstra);
+                REQUIRE(result.found == expected.found);
+                matches = matches && result.vertices.front() == start && result.vertices.back() == end;
+                int expectedLength = 0;
+                int length = 0;
+                for (size_t i = 1; i < expected.vertices.size(); ++i) {
+                    expectedLength += ring[expected.vertices[i - 1]][expected.vertices[i]];
+                }
+                for (size_t i = 1; i < result.vertices.size(); ++i) {
+                    length += ring[result.vertices[i - 1]][result.vertices[i]];
+                    matches = matches && ring[result.vertices[i - 1]][result.vertices[i]] != 0;
+                }
+                matches = matches && length == expectedLength;
+            }
+        }
+    }
+    CHECK(matches);
+
+    ariel::Graph g1;
+    vector<vector<int>> graph = {
+            {0, 4, 1, 0},
+            {0, 0, 0, 1},
+            {0, 2, 0, 6},
+            {0, 0, 0, 0}};
+    g1.loadGraph(graph);
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 3, ariel::ShortestPathMode::BidirectionalDijkstra) == "0->2->1->3");
+    CHECK(ariel::Algorithms::shortestPath(g1, 3, 0, ariel::ShortestPathMode::BidirectionalDijkstra) == "-1");
+    CHECK(ariel::Algorithms::shortestPath(g1, 2, 2, ariel::ShortestPathMode::BidirectionalDijkstra) == "2");
+    g1.setRepresentation(ariel::Representation::Sparse);
+    g1.setAdjacencyMatrix(2, 3, 1);
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 3, ariel::ShortestPathMode::BidirectionalDijkstra) == "0->2->3");
+
+    // 6x6 grid with unit weights; the Manhattan distance never overestimates
+    const size_t side = 6;
+    vector<vector<int>> grid(side * side, vector<int>(side * side, 0));
+    for (size_t r = 0; r < side; ++r) {
+        for (size_t c = 0; c < side; ++c) {
+            size_t v = r * side + c;
+            if (c + 1 < side) {
+                grid[v][v + 1] = grid[v + 1][v] = 1;
+            }
+            if (r + 1 < side) {
+                grid[v][v + side] = grid[v + side][v] = 1;
+            }
+        }
+    }
+    ariel::Graph g2;
+    g2.loadGraph(grid);
+    size_t target = side * side - 1;
+    ariel::DistanceHeuristic manhattan = [&](size_t v) {
+        return static_cast<int>((side - 1 - v / side) + (side - 1 - v % side));
+    };
+    ariel::PathResult guided = ariel::Algorithms::findShortestPathAStar(g2, 0, target, manhattan);
+    CHECK(guided.found);
+    CHECK(guided.vertices.size() == 2 * (side - 1) + 1);
+    CHECK(ariel::Algorithms::shortestPathAStar(g2, 0, 0, manhattan) == "0");
+    CHECK(ariel::Algorithms::shortestPathAStar(g1, 0, 3, [](size_t) { return 0; }) == ariel::Algorithms::shortestPath(g1, 0, 3));
+    CHECK(ariel::Algorithms::shortestPathAStar(g1, 3, 0, [](size_t) { return 0; }) == "-1");
+}
+
+TEST_CASE("Test bipartite check on sparse graphs")
+{
+    // Two components: a 4-cycle, then a triangle that is found only after the first component is colored
+    ariel::Graph g1;
+    vector<vector<int>> graph = {
+            {0, 1, 0, 1, 0, 0, 0},
+            {1, 0, 1, 0, 0, 0, 0},
+            {0, 1, 0, 1, 0, 0, 0},
+            {1, 0, 1, 0, 0, 0, 0},
+            {0, 0, 0, 0, 0, 1, 1},
+            {0, 0, 0, 0, 1, 0, 1},
+            {0, 0, 0, 0, 1, 1, 0}};
+    g1.loadGraph(graph, ariel::Representation::Sparse);
+    CHECK(ariel::Algorithms::isBipartite(g1) == "0");
+    CHECK_FALSE(ariel::Algorithms::findBipartition(g1).bipartite);
+
+    g1.setAdjacencyMatrix(5, 6, 0);
+    g1.setAdjacencyMatrix(6, 5, 0);
+    ariel::BipartiteResult result = ariel::Algorithms::findBipartition(g1);
+    CHECK(result.bipartite);
+    CHECK(result.sideA == vector<size_t>{0, 2, 4});
+    CHECK(result.sideB == vector<size_t>{1, 3, 5, 6});
+    g1.setRepresentation(ariel::Representation::Dense);
+    CHECK(ariel::Algorithms::isBipartite(g1) == "The graph is bipartite: A={0, 2, 4}, B={1, 3, 5, 6}.");
+}
+
+TEST_CASE("Test directed cycles and strongly connected components")
+{
+    // A DAG: read as directed it has no cycle
+    ariel::Graph g1;
+    vector<vector<int>> dag = {
+            {0, 1, 1, 0},
+            {0, 0, 1, 0},
+            {0, 0, 0, 1},
+            {0, 0, 0, 0}};
+    g1.loadGraph(dag);
+    CHECK(ariel::Algorithms::isContainsCycle(g1, ariel::GraphKind::Directed) == "-1");
+    CHECK_FALSE(ariel::Algorithms::isConnected(g1, ariel::GraphKind::Directed));
+    CHECK(ariel::Algorithms::findStronglyConnectedComponents(g1) == vector<vector<size_t>>{{3}, {2}, {1}, {0}});
+
+    g1.setAdjacencyMatrix(3, 1, 1);
+    CHECK(ariel::Algorithms::isContainsCycle(g1, ariel::GraphKind::Directed) == "1->2->3->1");
+    CHECK(ariel::Algorithms::findStronglyConnectedComponents(g1) == vector<vector<size_t>>{{1, 2, 3}, {0}});
+    g1.setAdjacencyMatrix(2, 2, 1);
+    CHECK(ariel::Algorithms::isContainsCycle(g1, ariel::GraphKind::Directed) == "2->2");
+    g1.setAdjacencyMatrix(2, 2, 0);
+
+    g1.setAdjacencyMatrix(3, 0, 1);
+    CHECK(ariel::Algorithms::isConnected(g1, ariel::GraphKind::Directed));
+    CHECK(ariel::Algorithms::findStronglyConnectedComponents(g1).size() == 1);
+
+    // Long directed ring: the iterative traversals do not grow the call stack
+    const size_t size = 3000;
+    vector<vector<int>> ring(size, vector<int>(size, 0));
+    for (size_t i = 0; i + 1 < size; ++i) {
+        ring[i][i + 1] = 1;
+    }
+    ariel::Graph g2;
+    g2.loadGraph(ring, ariel::Representation::Sparse);
+    CHECK(ariel::Algorithms::isContainsCycle(g2, ariel::GraphKind::Directed) == "-1");
+    CHECK_FALSE(ariel::Algorithms::isConnected(g2, ariel::GraphKind::Directed));
+    CHECK(ariel::Algorithms::findStronglyConnectedComponents(g2).size() == size);
+    g2.setAdjacencyMatrix(static_cast<int>(size) - 1, 0, 1);
+    CHECK(ariel::Algorithms::isConnected(g2, ariel::GraphKind::Directed));
+    CHECK(ariel::Algorithms::findCycle(g2, ariel::GraphKind::Directed).vertices.size() == size + 1);
+
+    ariel::Graph empty;
+    CHECK(ariel::Algorithms::isConnected(empty, ariel::GraphKind::Directed));
+    CHECK(ariel::Algorithms::findStronglyConnectedComponents(empty).empty());
+}
+
+TEST_CASE("Test incremental connectivity tracking")
+{
+    ariel::DisjointSets sets(5);
+    CHECK(sets.count() == 5);
+    CHECK(sets.unite(0, 1));
+    CHECK(sets.unite(3, 4));
+    CHECK_FALSE(sets.unite(1, 0));
+    CHECK(sets.connected(0, 1));
+    CHECK_FALSE(sets.connected(1, 3));
+    CHECK(sets.count() == 3);
+
+    // Add the edges of a path one at a time and ask after each insert
+    const int size = 200;
+    ariel::Graph g1(size, size);
+    g1.setConnectivityTracking(true);
+    CHECK(g1.tracksConnectivity());
+    bool connectedEarly = false;
+    for (int i = 0; i + 1 < size; ++i) {
+        connectedEarly = connectedEarly || ariel::Algorithms::isConnected(g1);
+        g1.setAdjacencyMatrix(i, i + 1, 1);
+        g1.setAdjacencyMatrix(i + 1, i, 1);
+    }
+    CHECK_FALSE(connectedEarly);
+    CHECK(ariel::Algorithms::isConnected(g1));
+    CHECK(g1.getComponents().count() == 1);
+
+    // Removing an edge rebuilds the components. A one-way edge leaves the graph asymmetric, and
+    // isConnected then traverses from vertex 0 like an untracked graph instead of asking the components.
+    g1.setAdjacencyMatrix(50, 51, 0);
+    CHECK_FALSE(g1.isSymmetric());
+    CHECK(g1.getComponents().count() == 1);
+    CHECK_FALSE(ariel::Algorithms::isConnected(g1));
+    g1.setAdjacencyMatrix(51, 50, 0);
+    CHECK_FALSE(ariel::Algorithms::isConnected(g1));
+    CHECK(g1.getComponents().count() == 2);
+
+    // Bulk operations keep the index current; the answers match an untracked graph
+    ariel::Graph g2;
+    vector<vector<int>> graph = {
+            {0, 1, 0},
+            {1, 0, 0},
+            {0, 0, 0}};
+    g2.loadGraph(graph);
+    g2.setConnectivityTracking(true);
+    CHECK_FALSE(ariel::Algorithms::isConnected(g2));
+    ++g2;
+    CHECK(ariel::Algorithms::isConnected(g2));
+    ariel::Graph negated = -g2;
+    CHECK(negated.tracksConnectivity());
+    CHECK(ariel::Algorithms::isConnected(negated));
+    g2.loadGraph(graph);
+    CHECK_FALSE(ariel::Algorithms::isConnected(g2));
+
+    g2.setConnectivityTracking(false);
+    CHECK(g2.getComponents().size() == 0);
+    CHECK_FALSE(ariel::Algorithms::isConnected(g2));
+
+    // Tracking never changes the answer on a directed matrix
+    vector<vector<vector<int>>> directed = {
+            {{0, 0}, {1, 0}},
+            {{0, 1}, {0, 0}},
+            {{0, 1, 0}, {0, 0, 1}, {1, 0, 0}},
+            {{0, 1, 0}, {1, 0, 0}, {0, 1, 0}}};
+    for (const vector<vector<int>>& matrix : directed) {
+        ariel::Graph untracked;
+        untracked.loadGraph(matrix);
+        ariel::Graph tracked;
+        tracked.loadGraph(matrix);
+        tracked.setConnectivityTracking(true);
+        CHECK(ariel::Algorithms::isConnected(tracked) == ariel::Algorithms::isConnected(untracked));
+    }
+    ariel::Graph g3;
+    g3.loadGraph(directed[0]);
+    g3.setConnectivityTracking(true);
+    CHECK_FALSE(ariel::Algorithms::isConnected(g3));
+    g3.setAdjacencyMatrix(0, 1, 1);
+    CHECK(g3.isSymmetric());
+    CHECK(ariel::Algorithms::isConnected(g3));
+}
+
+TEST_CASE("Test parallel direction-optimizing BFS connectivity")
+{
+    ariel::ThreadPool::setSharedThreadCount(4);
+
+    // Long path: narrow frontiers, every level runs top-down
+    const size_t length = 1500;
+    vector<vector<int>> path(length, vector<int>(length, 0));
+    for (size_t i = 0; i + 1 < length; ++i) {
+        path[i][i + 1] = 1;
+        path[i + 1][i] = 1;
+    }
+    ariel::Graph g1;
+    g1.loadGraph(path, ariel::Representation::Sparse);
+    CHECK(ariel::Algorithms::isConnected(g1));
+    g1.setAdjacencyMatrix(700, 701, 0); // 701 -> 700 is left, but 0 cannot get past 700
+    CHECK_FALSE(ariel::Algorithms::isConnected(g1));
+    g1.setAdjacencyMatrix(700, 701, 1);
+    CHECK(ariel::Algorithms::isConnected(g1));
+
+    // Two-level star: the wide second level switches to bottom-up
+    const size_t hubs = 40;
+    const size_t leaves = 40;
+    size_t size = 1 + hubs + hubs * leaves;
+    vector<vector<int>> star(size, vector<int>(size, 0));
+    for (size_t h = 0; h < hubs; ++h) {
+        size_t hub = 1 + h;
+        star[0][hub] = star[hub][0] = 1;
+        for (size_t l = 0; l < leaves; ++l) {
+            size_t leaf = 1 + hubs + h * leaves + l;
+            star[hub][leaf] = star[leaf][hub] = 1;
+        }
+    }
+    ariel::Graph sparse;
+    sparse.loadGraph(star, ariel::Representation::Sparse);
+    ariel::Graph dense;
+    dense.loadGraph(star, ariel::Representation::Dense);
+    CHECK(ariel::Algorithms::isConnected(sparse));
+    CHECK(ariel::Algorithms::isConnected(dense));
+
+    // Cut a leaf off its hub in the outgoing direction only: 0 no longer reaches it
+    sparse.setAdjacencyMatrix(5, 1 + hubs + 4 * leaves + 7, 0);
+    dense.setAdjacencyMatrix(5, 1 + hubs + 4 * leaves + 7, 0);
+    CHECK_FALSE(ariel::Algorithms::isConnected(sparse));
+    CHECK_FALSE(ariel::Algorithms::isConnected(dense));
+
+    ariel::ThreadPool::setSharedThreadCount(1);
+    sparse.setAdjacencyMatrix(5, 1 + hubs + 4 * leaves + 7, 1);
+    CHECK(ariel::Algorithms::isConnected(sparse));
+    ariel::ThreadPool::setSharedThreadCount(0);
+}
+
+TEST_CASE("Test negative cycle extraction")
+{
+    ariel::Graph g1;
+    vector<vector<int>> graph = {
+            {0, 6, 7, 0},
+            {0, 0, 8, 5},
+            {0, 0, 0, -3},
+            {0, -2, 0, 0}};
+    g1.loadGraph(graph);
+    CHECK_FALSE(ariel::Algorithms::findNegativeCycle(g1).found);
+
+    // Both 1->3->1 and 1->2->3->1 turn negative
+    graph[3][1] = -6;
+    g1.loadGraph(graph);
+    ariel::PathResult cycle = ariel::Algorithms::findNegativeCycle(g1);
+    REQUIRE(cycle.found);
+    CHECK(cycle.vertices.front() == cycle.vertices.back());
+    int weight = 0;
+    for (size_t i = 1; i < cycle.vertices.size(); ++i) {
+        weight += graph[cycle.vertices[i - 1]][cycle.vertices[i]];
+    }
+    CHECK(weight < 0);
+    CHECK(ariel::Algorithms::hasNegativeCycle(g1));
+
+    // Exchange-rate style loop 4->5->6->4 that vertex 0 cannot reach, next to a positive 0->1->2->3->0 loop
+    vector<vector<int>> rates(7, vector<int>(7, 0));
+    rates[0][1] = rates[1][2] = rates[2][3] = rates[3][0] = 2;
+    rates[4][5] = 3;
+    rates[5][6] = -1;
+    rates[6][4] = -4;
+    rates[5][3] = 1;
+    for (ariel::Representation representation : {ariel::Representation::Dense, ariel::Representation::Sparse}) {
+        ariel::Graph g2;
+        g2.loadGraph(rates, representation);
+        ariel::PathResult loop = ariel::Algorithms::findNegativeCycle(g2);
+        REQUIRE(loop.found);
+        REQUIRE(loop.vertices.size() == 4);
+        int total = 0;
+        for (size_t i = 1; i < loop.vertices.size(); ++i) {
+            REQUIRE(rates[loop.vertices[i - 1]][loop.vertices[i]] != 0);
+            total += rates[loop.vertices[i - 1]][loop.vertices[i]];
+        }
+        CHECK(total == -2);
+        CHECK(loop.vertices.front() == loop.vertices.back());
+    }
+
+    rates[6][4] = -1;
+    ariel::Graph g3;
+    g3.loadGraph(rates);
+    CHECK_FALSE(ariel::Algorithms::findNegativeCycle(g3).found);
+    CHECK(ariel::Algorithms::negativeCycle(g3) == "The graph does not contain a negative cycle.");
+}
+
+TEST_CASE("Weight types other than int")
+{
+    // Fractional weights: 0->1->2 costs 1.0, beating the direct 0->2 edge of 1.5
+    ariel::BasicGraph<double> g1;
+    vector<vector<double>> real = {
+        {0, 0.25, 1.5},
+        {0.25, 0, 0.75},
+        {1.5, 0.75, 0}};
+    g1.loadGraph(real);
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 2) == "0->1->2");
+    CHECK(ariel::Algorithms::isConnected(g1));
+    CHECK(ariel::BasicGraph<double>::INFINITE_DISTANCE == std::numeric_limits<double>::infinity());
+    ariel::BasicGraph<double> g2 = 2.0 * g1;
+    CHECK(g2.getAdjacencyMatrix()[0][2] == 3.0);
+    CHECK(g1.printGraph().find("0.25") != string::npos);
+    CHECK(ariel::Algorithms::floydWarshall(g1).distance(0, 2) == 1.0);
+
+    // Byte weights: the same graph in a quarter of the memory
+    ariel::BasicGraph<uint8_t> g3;
+    g3.loadGraph(vector<vector<uint8_t>>{
+        {0, 1, 0, 0},
+        {1, 0, 2, 0},
+        {0, 2, 0, 0},
+        {0, 0, 0, 0}}, ariel::Representation::Sparse);
+    CHECK(ariel::Algorithms::shortestPath(g3, 0, 2) == "0->1->2");
+    CHECK_FALSE(ariel::Algorithms::isConnected(g3));
+    CHECK(ariel::Algorithms::isBipartite(g3) == "The graph is bipartite: A={0, 2, 3}, B={1}.");
+    CHECK(ariel::BasicGraph<uint8_t>::INFINITE_DISTANCE == 255);
+    CHECK(g3.printGraph() == "[0, 1, 0, 0]\n[1, 0, 2, 0]\n[0, 2, 0, 0]\n[0, 0, 0, 0]");
+    ostringstream streamed;
+    streamed << g3;
+    CHECK(streamed.str() == "[0, 1, 0, 0]\n[1, 0, 2, 0]\n[0, 2, 0, 0]\n[0, 0, 0, 0]\n");
+    ariel::BasicGraph<int8_t> g5;
+    g5.loadGraph(vector<vector<int8_t>>{{0, 65}, {-1, 0}});
+    ostringstream signedStreamed;
+    signedStreamed << g5;
+    CHECK(signedStreamed.str() == "[0, 65]\n[-1, 0]\n");
+
+    // 64-bit weights past the int range, including a negative cycle
+    ariel::BasicGraph<int64_t> g4;
+    const int64_t big = 5000000000LL;
+    g4.loadGraph(vector<vector<int64_t>>{
+        {0, big, 0},
+        {0, 0, big},
+        {0, 0, 0}});
+    CHECK(ariel::Algorithms::allPairsShortestPaths(g4).getAdjacencyMatrix()[0][2] == 2 * big);
+    CHECK_FALSE(ariel::Algorithms::hasNegativeCycle(g4));
+    g4.loadGraph(vector<vector<int64_t>>{
+        {0, big, 0},
+        {0, 0, -big},
+        {-1, 0, 0}});
+    CHECK(ariel::Algorithms::hasNegativeCycle(g4));
+}
+
+TEST_CASE("Relaxations do not overflow on heavy weights")
+{
+    // 0->1->2 sums past INT_MAX; wrapped around it would undercut the direct 0->2 edge
+    vector<vector<int>> heavy = {
+        {0, 2000000000, 1000000000},
+        {0, 0, 2000000000},
+        {0, 0, 0}};
+    // 0->1->2 sums below INT_MIN; wrapped around it would lose to the direct 0->2 edge
+    vector<vector<int>> deep = {
+        {0, -2000000000, -1},
+        {0, 0, -2000000000},
+        {0, 0, 0}};
+    for (ariel::Representation representation : {ariel::Representation::Dense, ariel::Representation::Sparse}) {
+        ariel::Graph g1;
+        g1.loadGraph(heavy, representation);
+        ariel::Graph g2;
+        g2.loadGraph(deep, representation);
+        for (ariel::ShortestPathMode mode : {ariel::ShortestPathMode::Dijkstra, ariel::ShortestPathMode::BellmanFord,
+                                             ariel::ShortestPathMode::Spfa, ariel::ShortestPathMode::BidirectionalDijkstra}) {
+            CHECK(ariel::Algorithms::shortestPath(g1, 0, 2, mode) == "0->2");
+            CHECK(ariel::Algorithms::shortestPath(g1, 1, 2, mode) == "1->2");
+        }
+        CHECK(ariel::Algorithms::shortestPathAStar(g1, 0, 2, [](size_t) { return 0; }) == "0->2");
+        CHECK(ariel::Algorithms::shortestPath(g2, 0, 2, ariel::ShortestPathMode::BellmanFord) == "0->1->2");
+        CHECK(ariel::Algorithms::shortestPath(g2, 0, 2, ariel::ShortestPathMode::Spfa) == "0->1->2");
+        CHECK_FALSE(ariel::Algorithms::hasNegativeCycle(g2));
+    }
+
+    // 64-bit weights have no wider type; the sum saturates and stays longer than the direct edge
+    ariel::BasicGraph<int64_t> g3;
+    const int64_t huge = 6000000000000000000LL;
+    g3.loadGraph(vector<vector<int64_t>>{
+        {0, huge, 9000000000000000000LL},
+        {0, 0, huge},
+        {0, 0, 0}});
+    CHECK(ariel::Algorithms::shortestPath(g3, 0, 2, ariel::ShortestPathMode::Dijkstra) == "0->2");
+    CHECK(ariel::Algorithms::shortestPath(g3, 0, 2, ariel::ShortestPathMode::Spfa) == "0->2");
+}
+
+TEST_CASE("Move semantics")
+{
+    CHECK(std::is_nothrow_move_constructible<ariel::Graph>::value);
+    CHECK(std::is_nothrow_move_assignable<ariel::Graph>::value);
+
+    vector<vector<int>> graph = {
+        {0, 1, 2},
+        {1, 0, 3},
+        {2, 3, 0}};
+    ariel::Graph g1;
+    g1.loadGraph(graph, ariel::Representation::Sparse);
+    g1.setConnectivityTracking(true);
+    const int* buffer = g1.getAdjacencyMatrix().data();
+    ariel::Graph g2(std::move(g1));
+    CHECK(g2.getAdjacencyMatrix().data() == buffer);
+    CHECK(g2.isSparse());
+    CHECK(g2.getComponents().count() == 1);
+    CHECK(g1.getRows() == 0);
+    CHECK(g1.getAdjacencyMatrix().empty());
+    CHECK_FALSE(g1.isSparse());
+    CHECK_FALSE(g1.tracksConnectivity());
+    g1 = std::move(g2);
+    CHECK(g1.getAdjacencyMatrix().data() == buffer);
+    CHECK(g1.printGraph() == "[0, 1, 2]\n[1, 0, 3]\n[2, 3, 0]");
+    CHECK(g2.getRows() == 0);
+
+    // Assigning an expression to a graph of its size reuses that graph's buffer
+    ariel::Graph g3;
+    g3.loadGraph(graph);
+    ariel::Graph sum = g1 + g3;
+    const int* sumBuffer = sum.getAdjacencyMatrix().data();
+    sum = sum - g3 + g1;
+    CHECK(sum.getAdjacencyMatrix().data() == sumBuffer);
+    CHECK(sum.printGraph() == "[0, 2, 4]\n[2, 0, 6]\n[4, 6, 0]");
+    ariel::Graph g4;
+    g4.loadGraph(vector<vector<int>>(2, vector<int>(2, 1)));
+    CHECK_THROWS(g4 + g1);
+}
+
+TEST_CASE("Fused element-wise expressions")
+{
+    ariel::Graph g1;
+    g1.loadGraph(vector<vector<int>>{
+        {0, 1, 2},
+        {1, 0, 3},
+        {2, 3, 0}});
+    ariel::Graph g2;
+    g2.loadGraph(vector<vector<int>>{
+        {0, 2, 0},
+        {2, 0, 1},
+        {0, 1, 0}});
+    ariel::Graph g4;
+    g4.loadGraph(vector<vector<int>>{
+        {0, 1, 1},
+        {1, 0, 1},
+        {1, 1, 0}});
+
+    // Nothing is computed until the expression is assigned to a graph
+    auto expression = (g1 + g2) * 3 - g4;
+    CHECK(expression.cell(1) == 8);
+    ariel::Graph g5 = expression;
+    CHECK(g5.printGraph() == "[0, 8, 5]\n[8, 0, 11]\n[5, 11, 0]");
+    ariel::Graph g6 = -(g5 / 2) + 2 * g1 - +g2;
+    CHECK(g6.printGraph() == "[0, -4, 2]\n[-4, 0, 0]\n[2, 0, 0]");
+
+    // The result keeps the left-most graph's representation and connectivity tracking
+    g1.setRepresentation(ariel::Representation::Sparse);
+    g1.setConnectivityTracking(true);
+    ariel::Graph g7 = g1 - g1;
+    CHECK(g7.isSparse());
+    CHECK(g7.tracksConnectivity());
+    CHECK(g7.getSparseAdjacency().neighbors.empty());
+    CHECK(g7.getComponents().count() == 3);
+    CHECK_FALSE(ariel::Algorithms::isConnected(g7));
+
+    // Compound assignment and a graph that appears on both sides
+    g7 += g1 * 2 - g2;
+    CHECK(g7.printGraph() == "[0, 0, 4]\n[0, 0, 5]\n[4, 5, 0]");
+    g7 = g7 + g7 / 2;
+    CHECK(g7.printGraph() == "[0, 0, 6]\n[0, 0, 7]\n[6, 7, 0]");
+    CHECK(ariel::Graph((g1 + g1) * g4) == ariel::Graph(g1 * g4 * 2));
+
+    ariel::Graph g8(2, 2);
+    CHECK_THROWS(g1 + g2 - g8);
+    CHECK_THROWS((g1 + g2) / 0);
+}
+
+TEST_CASE("Element-wise kernels on large graphs")
+{
+    // 37 x 37 leaves a tail past every full 8- and 16-cell register
+    const size_t length = 37;
+    vector<vector<int>> a(length, vector<int>(length));
+    vector<vector<int>> b(length, vector<int>(length));
+    for (size_t i = 0; i < length; ++i) {
+        for (size_t j = 0; j < length; ++j) {
+            a[i][j] = static_cast<int>((i * 7 + j * 3) % 11) - 5;
+            b[i][j] = static_cast<int>((i + j * 5) % 13) - 6;
+        }
+    }
+    a[3][3] = INT_MAX; // A diagonal cell at the top of the range: ++ and -- must leave it alone
+    b[3][3] = 0;
+    ariel::Graph g1;
+    g1.loadGraph(a);
+    ariel::Graph g2;
+    g2.loadGraph(b);
+
+    ariel::Graph sum = g1;
+    sum += g2;
+    ariel::Graph difference = g1;
+    difference -= g2;
+    ariel::Graph scaled = g1;
+    scaled *= -3;
+    ariel::Graph incremented = g1;
+    ++incremented;
+    ariel::Graph decremented = g1;
+    --decremented;
+    --decremented;
+    for (size_t i = 0; i < length; ++i) {
+        for (size_t j = 0; j < length; ++j) {
+            bool diagonal = i == j;
+            REQUIRE(sum.getAdjacencyMatrix()[i][j] == a[i][j] + b[i][j]);
+            REQUIRE(difference.getAdjacencyMatrix()[i][j] == a[i][j] - b[i][j]);
+            if (i != 3 || j != 3) {
+                REQUIRE(scaled.getAdjacencyMatrix()[i][j] == a[i][j] * -3);
+            }
+            REQUIRE(incremented.getAdjacencyMatrix()[i][j] == (diagonal ? a[i][j] : a[i][j] + 1));
+            REQUIRE(decremented.getAdjacencyMatrix()[i][j] == (diagonal ? a[i][j] : a[i][j] - 2));
+        }
+    }
+
+    // Non-square and non-int graphs take the same fix-up path
+    ariel::BasicGraph<uint8_t> g3(2, 3);
+    --g3;
+    CHECK(g3.printGraph() == "[0, 255, 255]\n[255, 0, 255]");
+    ariel::BasicGraph<double> g4;
+    g4.loadGraph(vector<vector<double>>{{1e-20, 0.5}, {0.5, 1e-20}});
+    ++g4;
+    CHECK(g4.getAdjacencyMatrix()[0][0] == 1e-20);
+    CHECK(g4.getAdjacencyMatrix()[0][1] == 1.5);
+
+    string kernel = ariel::kernels::elementwiseKernelName();
+    CHECK((kernel == "avx512" || kernel == "avx2" || kernel == "scalar"));
+}
+
+TEST_CASE("Division by an invariant scalar")
+{
+    // 37 x 37 leaves a scalar tail after every vector width
+    const size_t length = 37;
+    vector<vector<int>> a(length, vector<int>(length, 0));
+    for (size_t i = 0; i < length; ++i) {
+        for (size_t j = 0; j < length; ++j) {
+            if ((i + j) % 5 != 0) {
+                a[i][j] = static_cast<int>(i * 7919 + j * 104729) * ((i + j) % 2 == 0 ? 1 : -1);
+            }
+        }
+    }
+    a[1][2] = INT_MAX;
+    a[2][1] = INT_MIN + 1;
+    ariel::Graph g1;
+    g1.loadGraph(a);
+
+    const int divisors[] = {1, -1, 2, -2, 3, 7, -7, 16, 641, -1000003, INT_MAX};
+    for (int divisor : divisors) {
+        ariel::Graph assigned = g1;
+        assigned /= divisor;
+        ariel::Graph fused = g1 / divisor;
+        for (size_t i = 0; i < length; ++i) {
+            for (size_t j = 0; j < length; ++j) {
+                REQUIRE(assigned.getAdjacencyMatrix()[i][j] == a[i][j] / divisor);
+                REQUIRE(fused.getAdjacencyMatrix()[i][j] == a[i][j] / divisor);
+            }
+        }
+    }
+
+    // Zero cells stay zero instead of dividing by zero
+    ariel::Graph inverted = 1000000 / g1;
+    for (size_t i = 0; i < length; ++i) {
+        for (size_t j = 0; j < length; ++j) {
+            REQUIRE(inverted.getAdjacencyMatrix()[i][j] == (a[i][j] == 0 ? 0 : 1000000 / a[i][j]));
+        }
+    }
+    CHECK_THROWS(g1 /= 0);
+    CHECK_THROWS(0 / g1);
+}
+
+TEST_CASE("Loading from caller-owned buffers")
+{
+    vector<int> cells = {0, 1, 0, 1, 0, 2, 0, 2, 0};
+    const int* storage = cells.data();
+
+    // An adopted flat buffer becomes the graph's storage as is
+    ariel::Graph adopted;
+    adopted.loadGraph(std::move(cells), 3, 3);
+    CHECK(adopted.getAdjacencyMatrix().data() == storage);
+    CHECK(cells.empty());
+    CHECK_FALSE(adopted.isView());
+    CHECK(adopted.printGraph() == "[0, 1, 0]\n[1, 0, 2]\n[0, 2, 0]");
+
+    // A packed view reads the caller's cells in place until the first write
+    const int packed[] = {0, 3, 0, 0, 3, 0, 4, 0, 0, 4, 0, 5, 0, 0, 5, 0};
+    ariel::Graph view;
+    view.loadGraph(packed, 4, 4, 4);
+    CHECK(view.isView());
+    CHECK(view.getAdjacencyMatrix().data() == packed);
+    CHECK(ariel::Algorithms::isConnected(view) == true);
+    ariel::Graph copy = view;
+    CHECK(copy.getAdjacencyMatrix().data() == packed);
+    CHECK(view == copy);
+    ariel::Graph sum = view + copy;
+    CHECK(sum.getAdjacencyMatrix()[2][3] == 10);
+    copy.setAdjacencyMatrix(2, 3, 0);
+    CHECK_FALSE(copy.isView());
+    CHECK(copy.getAdjacencyMatrix()[2][3] == 0);
+    CHECK(packed[11] == 5);
+    CHECK(view.getAdjacencyMatrix()[2][3] == 5);
+    view *= 2;
+    CHECK_FALSE(view.isView());
+    CHECK(view.getAdjacencyMatrix()[2][3] == 10);
+
+    // Padded rows are packed into the graph's own storage
+    const int padded[] = {0, 7, -1, 7, 0, -1};
+    ariel::Graph strided;
+    strided.loadGraph(padded, 2, 2, 3);
+    CHECK_FALSE(strided.isView());
+    CHECK(strided.printGraph() == "[0, 7]\n[7, 0]");
+
+    // A temporary nested matrix is released row by row
+    vector<vector<int>> nested = {{0, 1}, {1, 0}};
+    ariel::Graph moved;
+    moved.loadGraph(std::move(nested));
+    CHECK(nested.empty());
+    CHECK(moved.printGraph() == "[0, 1]\n[1, 0]");
+
+    // Mismatched dimensions leave the graph as it was
+    ariel::Graph rejected;
+    rejected.loadGraph(vector<int>(5, 1), 2, 3);
+    CHECK(rejected.getRows() == 0);
+    rejected.loadGraph(padded, 2, 3, 2);
+    CHECK(rejected.getRows() == 0);
+}
+
+TEST_CASE("Negative cycles are found after distances saturate")
+{
+    // 0 <-> 1 drives 64-bit and floating-point distances to the bottom of their range within a few
+    // relaxations, long before a path of V edges would prove the cycle
+    ariel::BasicGraph<int64_t> g1;
+    vector<vector<int64_t>> wide(100, vector<int64_t>(100, 0));
+    wide[0][1] = wide[1][0] = -4000000000000000000LL;
+    g1.loadGraph(wide);
+    CHECK(ariel::Algorithms::hasNegativeCycle(g1));
+    ariel::PathResult cycle = ariel::Algorithms::findNegativeCycle(g1);
+    CHECK(cycle.found);
+    CHECK(cycle.vertices.size() == 3);
+    CHECK(cycle.vertices.front() == cycle.vertices.back());
+    CHECK(ariel::Algorithms::floydWarshall(g1).hasNegativeCycle());
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 1, ariel::ShortestPathMode::BellmanFord) == "-1");
+    CHECK(ariel::Algorithms::shortestPath(g1, 0, 1, ariel::ShortestPathMode::Spfa) == "-1");
+
+    ariel::BasicGraph<float> g2;
+    vector<vector<float>> narrow(100, vector<float>(100, 0));
+    narrow[0][1] = narrow[1][0] = -1e38f;
+    g2.loadGraph(narrow);
+    CHECK(ariel::Algorithms::hasNegativeCycle(g2));
+    CHECK(ariel::Algorithms::findNegativeCycle(g2).found);
+    CHECK(ariel::Algorithms::shortestPath(g2, 0, 1, ariel::ShortestPathMode::BellmanFord) == "-1");
+    CHECK(ariel::Algorithms::shortestPath(g2, 0, 1, ariel::ShortestPathMode::Spfa) == "-1");
+
+    ariel::BasicGraph<double> g3;
+    vector<vector<double>> precise(100, vector<double>(100, 0));
+    precise[0][1] = precise[1][0] = -1e308;
+    g3.loadGraph(precise);
+    CHECK(ariel::Algorithms::hasNegativeCycle(g3));
+    CHECK(ariel::Algorithms::findNegativeCycle(g3).found);
+    CHECK(ariel::Algorithms::shortestPath(g3, 0, 1, ariel::ShortestPathMode::BellmanFord) == "-1");
+    CHECK(ariel::Algorithms::shortestPath(g3, 0, 1, ariel::ShortestPathMode::Spfa) == "-1");
+
+    // A path that merely runs into the floor, with no cycle, is still answered
+    ariel::BasicGraph<int64_t> g4;
+    g4.loadGraph(vector<vector<int64_t>>{
+        {0, -6000000000000000000LL, 0},
+        {0, 0, -6000000000000000000LL},
+        {0, 0, 0}});
+    CHECK_FALSE(ariel::Algorithms::hasNegativeCycle(g4));
+    CHECK(ariel::Algorithms::shortestPath(g4, 0, 2, ariel::ShortestPathMode::BellmanFord) == "0->1->2");
+}
+
+TEST_CASE("The graph keeps its edge and negative counts as cells change")
+{
+    ariel::Graph g;
+    g.loadGraph({
+        {0, 1, 0},
+        {0, 0, -2},
+        {0, 0, 0}});
+    CHECK(g.getEdgeCount() == 2);
+    CHECK(g.hasNegativeWeight());
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 2) == "0->1->2");
+
+    g.setAdjacencyMatrix(1, 2, 3);
+    CHECK(g.getEdgeCount() == 2);
+    CHECK_FALSE(g.hasNegativeWeight());
+    g.setAdjacencyMatrix(0, 1, 0);
+    CHECK(g.getEdgeCount() == 1);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 2) == "-1");
+
+    g.setRepresentation(ariel::Representation::Sparse);
+    g.setAdjacencyMatrix(0, 1, -4);
+    CHECK(g.getEdgeCount() == 2);
+    CHECK(g.hasNegativeWeight());
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 2) == "0->1->2");
+
+    ariel::Graph negated = -g;
+    CHECK(negated.getEdgeCount() == 2);
+    CHECK(negated.hasNegativeWeight());
+    ariel::Graph cleared = g * 0;
+    CHECK(cleared.getEdgeCount() == 0);
+    CHECK_FALSE(cleared.hasNegativeWeight());
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace ariel {
+
+    namespace {
+        // Chunks handed out per thread; more than one smooths out uneven chunk costs
+        const std::size_t CHUNKS_PER_THREAD = 4;
+
+        // Set while this thread is executing a parallelFor chunk
+        thread_local bool insideTask = false;
+
+        std::size_t defaultThreadCount() {
+            unsigned int hardware = std::thread::hardware_concurrency();
+            return hardware == 0 ? 1 : static_cast<std::size_t>(hardware);
+        }
+    }
+
+/**
+ * @brief Start threadCount - 1 worker threads; the caller of parallelFor is the last thread.
+ *
+ * @param threadCount Total number of threads, at least 1.
+ */
+    ThreadPool::ThreadPool(std::size_t threadCount)
+            : task(nullptr), rangeBegin(0), rangeEnd(0), chunkSize(0), chunkCount(0), nextChunk(0),
+              pendingChunks(0), generation(0), stopping(false) {
+        for (std::size_t i = 1; i < threadCount; ++i) {
+            workers.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+/**
+ * @brief Stop and join every worker thread.
+ */
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+/**
+ * @brief Split [begin, end) into contiguous chunks, run them on the pool and the calling thread, and wait.
+ *
+ * @param begin First index.
+ * @param end One past the last index.
+ * @param task Called as task(chunkBegin, chunkEnd) once per chunk.
+ * @throws Whatever the first failing chunk threw.
+ */
+    void ThreadPool::parallelFor(std::size_t begin, std::size_t end, const RangeTask& task) {
+        if (begin >= end) {
+            return;
+        }
+        if (workers.empty() || insideTask) {
+            task(begin, end);
+            return;
+        }
+
+        std::lock_guard<std::mutex> call(callMutex);
+        std::unique_lock<std::mutex> lock(stateMutex);
+        std::size_t length = end - begin;
+        this->task = &task;
+        rangeBegin = begin;
+        rangeEnd = end;
+        chunkCount = std::min(length, size() * CHUNKS_PER_THREAD);
+        chunkSize = (length + chunkCount - 1) / chunkCount;
+        chunkCount = (length + chunkSize - 1) / chunkSize;
+        nextChunk = 0;
+        pendingChunks = chunkCount;
+        failure = nullptr;
+        ++generation;
+        workAvailable.notify_all();
+
+        runChunks(lock);
+        workFinished.wait(lock, [this] { return pendingChunks == 0; });
+        this->task = nullptr;
+
+        if (failure) {
+            std::exception_ptr error = failure;
+            failure = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+/**
+ * @brief Claim and run chunks of the current job until none are left. Called with stateMutex held.
+ *
+ * @param lock The held lock on stateMutex; released while a chunk runs.
+ */
+    void ThreadPool::runChunks(std::unique_lock<std::mutex>& lock) {
+        while (task != nullptr && nextChunk < chunkCount) {
+            std::size_t chunk = nextChunk++;
+            std::size_t chunkBegin = rangeBegin + chunk * chunkSize;
+            std::size_t chunkEnd = std::min(chunkBegin + chunkSize, rangeEnd);
+            const RangeTask& current = *task;
+
+            lock.unlock();
+            insideTask = true;
+            std::exception_ptr error;
+            try {
+                current(chunkBegin, chunkEnd);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            insideTask = false;
+            lock.lock();
+
+            if (error && !failure) {
+                failure = error;
+            }
+            if (--pendingChunks == 0) {
+                workFinished.notify_all();
+            }
+        }
+    }
+
+/**
+ * @brief Worker thread body: sleep until a new job is published, help run it, repeat.
+ */
+    void ThreadPool::workerLoop() {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        std::size_t seenGeneration = generation;
+        while (true) {
+            workAvailable.wait(lock, [this, seenGeneration] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+            runChunks(lock);
+        }
+    }
+
+/**
+ * @brief Storage for the shared pool, created on first use with one thread per hardware thread.
+ *
+ * @return std::unique_ptr<ThreadPool>& The owning pointer.
+ */
+    std::unique_ptr<ThreadPool>& ThreadPool::sharedInstance() {
+        static std::unique_ptr<ThreadPool> instance(new ThreadPool(defaultThreadCount()));
+        return instance;
+    }
+
+/**
+ * @brief Get the process-wide pool used by the Graph operators.
+ *
+ * @return ThreadPool& The shared pool.
+ */
+    ThreadPool& ThreadPool::shared() {
+        return *sharedInstance();
+    }
+
+/**
+ * @brief Replace the shared pool with one of the given size.
+ *
+ * @param threadCount Total number of threads; 0 selects the hardware concurrency.
+ */
+    void ThreadPool::setSharedThreadCount(std::size_t threadCount) {
+        std::unique_ptr<ThreadPool>& instance = sharedInstance();
+        instance.reset();
+        instance.reset(new ThreadPool(threadCount == 0 ? defaultThreadCount() : threadCount));
+    }
+
+/**
+ * @brief Get the size of the shared pool.
+ *
+ * @return std::size_t Number of threads, the caller included.
+ */
+    std::size_t ThreadPool::getSharedThreadCount() {
+        return shared().size();
+    }
+
+} // namespace ariel
\ No newline at end of file
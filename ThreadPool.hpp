@@ -0,0 +1,69 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <cstddef>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ariel {
+
+    // Fixed set of worker threads that split index ranges between themselves and the caller.
+    // Threads are started once and reused by every parallelFor call.
+    class ThreadPool {
+    public:
+        typedef std::function<void(std::size_t, std::size_t)> RangeTask;
+
+        // threadCount counts the calling thread, so 1 means "run everything serially"
+        explicit ThreadPool(std::size_t threadCount);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Number of threads taking part in parallelFor, the caller included
+        std::size_t size() const { return workers.size() + 1; }
+
+        // Run task over [begin, end) split into contiguous chunks and wait for all of them.
+        // Calls made from inside a running task execute serially on the calling thread.
+        // The first exception thrown by a chunk is rethrown here.
+        void parallelFor(std::size_t begin, std::size_t end, const RangeTask& task);
+
+        // Process-wide pool used by the Graph operators
+        static ThreadPool& shared();
+
+        // Resize the shared pool; must not be called while another thread is using it
+        static void setSharedThreadCount(std::size_t threadCount);
+        static std::size_t getSharedThreadCount();
+
+    private:
+        std::vector<std::thread> workers;
+        std::mutex callMutex; // One parallelFor at a time
+        std::mutex stateMutex;
+        std::condition_variable workAvailable;
+        std::condition_variable workFinished;
+
+        const RangeTask* task;
+        std::size_t rangeBegin;
+        std::size_t rangeEnd;
+        std::size_t chunkSize;
+        std::size_t chunkCount;
+        std::size_t nextChunk;
+        std::size_t pendingChunks;
+        std::size_t generation;
+        bool stopping;
+        std::exception_ptr failure;
+
+        void workerLoop();
+        void runChunks(std::unique_lock<std::mutex>& lock);
+
+        static std::unique_ptr<ThreadPool>& sharedInstance();
+    };
+
+} // namespace ariel
+
+#endif // THREADPOOL_HPP
\ No newline at end of file